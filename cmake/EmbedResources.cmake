@@ -0,0 +1,28 @@
+# embed_resources(<target> <name>=<path> ...)
+# Embed files in the target at build time, as 64-byte aligned constexpr arrays of 32-bit words registered under their
+# names, see core/embedded.h. Relative paths are from the current source folder
+
+set(EMBED_RESOURCES_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/embed.cmake)
+
+function(embed_resources target)
+    set(output ${CMAKE_CURRENT_BINARY_DIR}/${target}_embedded.cpp)
+    set(resources "")
+    set(paths "")
+    foreach(resource ${ARGN})
+        string(REGEX MATCH "^[^=]+" name "${resource}")
+        string(REGEX REPLACE "^[^=]+=" "" path "${resource}")
+        get_filename_component(path ${path} ABSOLUTE BASE_DIR ${CMAKE_CURRENT_SOURCE_DIR})
+        list(APPEND paths ${path})
+        # Semicolons would split the command arguments
+        string(APPEND resources "${name}=${path}|")
+    endforeach()
+
+    add_custom_command(
+        OUTPUT ${output}
+        COMMAND ${CMAKE_COMMAND} -DOUTPUT=${output} -DRESOURCES=${resources} -P ${EMBED_RESOURCES_SCRIPT}
+        DEPENDS ${paths} ${EMBED_RESOURCES_SCRIPT}
+        COMMENT "Embedding resources in ${target}"
+        VERBATIM
+    )
+    target_sources(${target} PRIVATE ${output})
+endfunction()
@@ -0,0 +1,41 @@
+# cmake -DOUTPUT=<file.cpp> -DRESOURCES=<name>=<path>|... -P embed.cmake
+# Write a source registering each file as an array of little-endian 32-bit words, zero-padded
+
+string(REPLACE "|" ";" resources "${RESOURCES}")
+
+set(arrays "")
+set(registrations "")
+set(index 0)
+foreach(resource ${resources})
+    string(REGEX MATCH "^[^=]+" name "${resource}")
+    string(REGEX REPLACE "^[^=]+=" "" path "${resource}")
+    file(SIZE ${path} size)
+    file(READ ${path} hex HEX)
+
+    # Pad to whole words, then swap bytes into little-endian words, 8 per line
+    math(EXPR padding "(4 - ${size} % 4) % 4")
+    string(REPEAT "00" ${padding} zeros)
+    string(APPEND hex "${zeros}")
+    string(REGEX REPLACE "(..)(..)(..)(..)" "0x\\4\\3\\2\\1, " words "${hex}")
+    string(REGEX REPLACE "((0x........, ){8})" "\\1\n    " words "${words}")
+    if(size EQUAL 0)
+        set(words "0")
+    endif()
+
+    string(APPEND arrays "alignas(64) constexpr uint32_t resource${index}[] = {\n    ${words}\n};\n\n")
+    string(APPEND registrations
+        "const EmbeddedRegistration registration${index}{\"${name}\", resource${index}, ${size}};\n"
+    )
+    math(EXPR index "${index} + 1")
+endforeach()
+
+set(content "// Generated by embed.cmake\n#include <core/embedded.h>\n\nnamespace galaxias\n{\nnamespace\n{\n\n")
+string(APPEND content "${arrays}${registrations}\n} // namespace\n} // namespace galaxias\n")
+
+# Only touch the output when it changes, to avoid rebuilds
+if(EXISTS ${OUTPUT})
+    file(READ ${OUTPUT} previous)
+endif()
+if(NOT previous STREQUAL content)
+    file(WRITE ${OUTPUT} "${content}")
+endif()
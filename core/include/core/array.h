@@ -1,7 +1,11 @@
 #pragma once
 
+#include <array>
 #include <memory>
+#include <memory_resource>
 #include <numeric>
+#include <span>
+#include <type_traits>
 
 namespace galaxias
 {
@@ -12,6 +16,9 @@ enum class MemType
     Device,
 };
 
+template <class T, size_t D, MemType M>
+class StridedView;
+
 template <class T, size_t D, MemType M>
 class Array
 {
@@ -60,6 +67,10 @@ public:
     const T& operator[](size_t index) const { return data_[index]; }
     const T& operator[](const Dims& index) const { return operator[](indexOf(index)); }
 
+    /// Zero-copy view, to slice, transpose or take sub-blocks
+    StridedView<T, D, M> view() { return {data_, dims_}; }
+    StridedView<const T, D, M> view() const { return {data_, dims_}; }
+
 protected:
     size_t indexOf(const Dims& index) const
     {
@@ -88,14 +99,40 @@ using ArrayView = Array<T, D, MemType::Host>;
 template <class T>
 using View1DArray = ArrayView<T, 1>;
 
-template <class T, size_t D, MemType M = MemType::Host>
+/// Tag for resizing without initialising the new elements, for buffers about to be overwritten
+struct DefaultInit
+{
+};
+constexpr DefaultInit defaultInit{};
+
+/// Blocking copy and zero-fill of device memory, through the Device the memory was allocated on (see device.h).
+/// Throws std::runtime_error if the resource is not a Device
+void copyDeviceMemory(std::pmr::memory_resource& resource, const void* source, void* destination, size_t bytes);
+void zeroDeviceMemory(std::pmr::memory_resource& resource, void* destination, size_t bytes);
+
+/// Default alignment of owned arrays: a cache line, which also covers the widest SIMD registers (AVX-512)
+constexpr size_t defaultAlignment{64};
+
+/// Array owning its memory. Allocations are aligned on A bytes and their capacity is padded to a whole number of
+/// A-byte vectors, so that SIMD kernels can run over paddedSize() elements without peel or remainder loops.
+/// Device arrays are allocated on a Device, which then runs their copies and zero-fills
+template <class T, size_t D, MemType M = MemType::Host, size_t A = defaultAlignment>
 class OwningArray : public Array<T, D, M>
 {
+    static_assert(std::is_trivially_copyable_v<T>, "OwningArray moves its elements with memcpy");
+    static_assert(A >= alignof(T) && (A & (A - 1)) == 0, "Alignment must be a power of 2, at least alignof(T)");
+
 public:
     using Dims = typename Array<T, D, M>::Dims;
 
+    static constexpr size_t alignment{A};
+    /// Smallest number of elements spanning whole A-byte vectors, e.g. 16 elements of 12 bytes for 3 vectors of 64
+    static constexpr size_t vectorSize{std::lcm(A, sizeof(T)) / sizeof(T)};
+
     OwningArray();
-    OwningArray(const Dims& dims);
+    explicit OwningArray(std::pmr::memory_resource* resource);
+    OwningArray(const Dims& dims, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    /// Copies allocate from the resource of the array they copy
     OwningArray(const OwningArray&);
     OwningArray(OwningArray&&) noexcept;
     ~OwningArray();
@@ -103,18 +140,161 @@ public:
     OwningArray& operator=(const OwningArray&);
     OwningArray& operator=(OwningArray&&) noexcept;
 
+    /// Grow the capacity to at least the given number of elements, never shrinking
     void reserve(size_t capacity);
+    /// Resize, zeroing elements past the previous size
     void resize(const Dims& dims);
+    /// Resize, leaving elements past the previous size uninitialised
+    void resize(const Dims& dims, DefaultInit);
+    /// Release the capacity beyond paddedSize()
+    void shrink_to_fit();
+
+    // 1D appends
+    void push_back(const T& value)
+        requires(D == 1 && M == MemType::Host);
+    template <class... Args>
+    T& emplace_back(Args&&... args)
+        requires(D == 1 && M == MemType::Host);
+    void append(std::span<const T> values)
+        requires(D == 1);
 
     size_t capacity() const { return capacity_; }
+    std::pmr::memory_resource* resource() const { return resource_; }
+    /// Size rounded up to whole vectors, always within capacity
+    size_t paddedSize() const { return padded(this->size()); }
+
+    /// Data pointer the compiler knows to be aligned on A bytes
+    T* alignedData() { return std::assume_aligned<A>(this->data_); }
+    const T* alignedData() const { return std::assume_aligned<A>(this->data_); }
+
+private:
+    static size_t padded(size_t size) { return (size + vectorSize - 1) / vectorSize * vectorSize; }
+    void grow(size_t size);
+    void reallocate(size_t capacity);
+    T* allocate(size_t capacity);
+    void deallocate(T* data, size_t capacity);
+    void copyElements(T* destination, const T* source, size_t count);
+    void zeroElements(T* destination, size_t count);
 
 private:
     size_t capacity_;
+    std::pmr::memory_resource* resource_;
 };
 
 template <class T>
 using Owning1DArray = OwningArray<T, 1>;
 
+/// View on D-dimensional data with arbitrary strides (in elements), sharing the memory of the array it comes from.
+/// Slices, sub-blocks and transpositions are views themselves. Iteration is in row-major order of the view's dims;
+/// forEach() runs plain loops over the rows that are contiguous, so that they can be vectorised
+template <class T, size_t D, MemType M = MemType::Host>
+class StridedView
+{
+public:
+    using value_type = std::remove_const_t<T>;
+    using Dims = std::array<size_t, D>;
+
+    class Iterator;
+
+    /// Dense row-major view
+    StridedView(T* data, const Dims& dims);
+    StridedView(T* data, const Dims& dims, const Dims& strides);
+    /// Views on mutable data convert to views on const data
+    template <class U>
+        requires std::is_convertible_v<U*, T*>
+    StridedView(const StridedView<U, D, M>& rhs)
+        : StridedView(rhs.data(), rhs.dims(), rhs.strides())
+    {
+    }
+
+    T* data() const { return data_; }
+    const Dims& dims() const { return dims_; }
+    const Dims& strides() const { return strides_; }
+    size_t size() const;
+
+    T& operator[](const Dims& index) const { return data_[offsetOf(index)]; }
+    T& operator[](size_t index) const
+        requires(D == 1)
+    {
+        return data_[index * strides_[0]];
+    }
+
+    /// Whether elements are packed in row-major order, hence available as a span
+    bool contiguous() const;
+    /// Contiguous elements, throws std::runtime_error otherwise
+    std::span<T> span() const;
+
+    /// View with the given dimension fixed at index
+    StridedView<T, D - 1, M> slice(size_t dim, size_t index) const
+        requires(D > 1);
+    /// Block of the given dims starting at offset
+    StridedView subarray(const Dims& offset, const Dims& dims) const;
+    /// Reverse the order of dimensions, or swap two of them
+    StridedView transpose() const;
+    StridedView transpose(size_t first, size_t second) const;
+    StridedView<T, 1, M> row(size_t index) const
+        requires(D == 2)
+    {
+        return slice(0, index);
+    }
+    StridedView<T, 1, M> column(size_t index) const
+        requires(D == 2)
+    {
+        return slice(1, index);
+    }
+
+    /// Call fn(element) on each element, in row-major order
+    template <class F>
+    void forEach(F&& fn) const;
+
+    Iterator begin() const { return Iterator{*this, 0}; }
+    Iterator end() const { return Iterator{*this, size()}; }
+
+private:
+    size_t offsetOf(const Dims& index) const;
+
+private:
+    T* data_;
+    Dims dims_;
+    Dims strides_;
+};
+
+/// Forward iterator in row-major order, stepping through memory directly when the view is contiguous. Holds a copy of
+/// the view's geometry, so it outlives temporary views (e.g. iterating over array.view().row(i))
+template <class T, size_t D, MemType M>
+class StridedView<T, D, M>::Iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::remove_const_t<T>;
+    using difference_type = ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    Iterator() = default;
+    /// Position is 0 for the first element, or size() for the end
+    Iterator(const StridedView& view, size_t position);
+
+    T& operator*() const { return *current_; }
+    T* operator->() const { return current_; }
+    Iterator& operator++();
+    Iterator operator++(int)
+    {
+        Iterator it = *this;
+        ++*this;
+        return it;
+    }
+    bool operator==(const Iterator& rhs) const { return position_ == rhs.position_; }
+
+private:
+    T* current_{nullptr};
+    Dims dims_{};
+    Dims strides_{};
+    Dims index_{};
+    size_t position_{0};
+    bool contiguous_{false};
+};
+
 } // namespace galaxias
 
 #include "array.inl"
@@ -1,91 +1,452 @@
+#include <algorithm>
 #include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
 
 namespace galaxias
 {
 
-template <class T, size_t D, MemType M>
-OwningArray<T, D, M>::OwningArray()
+template <class T, size_t D, MemType M, size_t A>
+OwningArray<T, D, M, A>::OwningArray()
+    : OwningArray<T, D, M, A>(std::pmr::get_default_resource())
+{
+}
+
+template <class T, size_t D, MemType M, size_t A>
+OwningArray<T, D, M, A>::OwningArray(std::pmr::memory_resource* resource)
     : Array<T, D, M>(nullptr, Dims{0})
     , capacity_{0}
+    , resource_{resource}
 {
 }
 
-template <class T, size_t D, MemType M>
-OwningArray<T, D, M>::OwningArray(const Dims& dims)
-    : OwningArray<T, D, M>()
+template <class T, size_t D, MemType M, size_t A>
+OwningArray<T, D, M, A>::OwningArray(const Dims& dims, std::pmr::memory_resource* resource)
+    : OwningArray<T, D, M, A>(resource)
 {
     resize(dims);
 }
 
-template <class T, size_t D, MemType M>
-OwningArray<T, D, M>::OwningArray(const OwningArray& rhs)
-    : OwningArray<T, D, M>(rhs.dims_)
+template <class T, size_t D, MemType M, size_t A>
+OwningArray<T, D, M, A>::OwningArray(const OwningArray& rhs)
+    : OwningArray<T, D, M, A>(rhs.resource_)
 {
-    memcpy(Array<T, D, M>::data_, rhs.data(), capacity_ * sizeof(T));
+    resize(rhs.dims_, defaultInit);
+    if (rhs.data())
+    {
+        copyElements(Array<T, D, M>::data_, rhs.data(), rhs.size());
+    }
 }
 
-template <class T, size_t D, MemType M>
-OwningArray<T, D, M>::OwningArray(OwningArray&& rhs) noexcept
+template <class T, size_t D, MemType M, size_t A>
+OwningArray<T, D, M, A>::OwningArray(OwningArray&& rhs) noexcept
     : Array<T, D, M>{rhs.data_, rhs.dims_}
     , capacity_{rhs.capacity_}
+    , resource_{rhs.resource_}
 {
     rhs.data_ = nullptr;
     rhs.capacity_ = 0;
 }
 
-template <class T, size_t D, MemType M>
-OwningArray<T, D, M>::~OwningArray()
+template <class T, size_t D, MemType M, size_t A>
+OwningArray<T, D, M, A>::~OwningArray()
 {
-    if (Array<T, D, M>::data_)
-    {
-        delete[] Array<T, D, M>::data_;
-    }
+    deallocate(Array<T, D, M>::data_, capacity_);
 }
 
-template <class T, size_t D, MemType M>
-OwningArray<T, D, M>& OwningArray<T, D, M>::operator=(const OwningArray& rhs)
+template <class T, size_t D, MemType M, size_t A>
+OwningArray<T, D, M, A>& OwningArray<T, D, M, A>::operator=(const OwningArray& rhs)
 {
-    resize(rhs.dims());
-    memcpy(Array<T, D, M>::data_, rhs.data(), capacity_ * sizeof(T));
+    if (this != &rhs)
+    {
+        resize(rhs.dims(), defaultInit);
+        if (rhs.data())
+        {
+            copyElements(Array<T, D, M>::data_, rhs.data(), rhs.size());
+        }
+    }
     return *this;
 }
 
-template <class T, size_t D, MemType M>
-OwningArray<T, D, M>& OwningArray<T, D, M>::operator=(OwningArray&& rhs) noexcept
+template <class T, size_t D, MemType M, size_t A>
+OwningArray<T, D, M, A>& OwningArray<T, D, M, A>::operator=(OwningArray&& rhs) noexcept
 {
-    if (Array<T, D, M>::data_)
+    if (this == &rhs)
     {
-        delete[] Array<T, D, M>::data_;
+        return *this;
     }
+    deallocate(Array<T, D, M>::data_, capacity_);
     Array<T, D, M>::data_ = rhs.data_;
     Array<T, D, M>::dims_ = rhs.dims_;
     capacity_ = rhs.capacity_;
+    resource_ = rhs.resource_;
 
     rhs.data_ = nullptr;
+    rhs.capacity_ = 0;
     return *this;
 }
 
-template <class T, size_t D, MemType M>
-void OwningArray<T, D, M>::reserve(size_t capacity)
+template <class T, size_t D, MemType M, size_t A>
+void OwningArray<T, D, M, A>::reserve(size_t capacity)
 {
     if (capacity > capacity_)
     {
-        T* newData = new T[capacity];
-        if (Array<T, D, M>::data_)
+        reallocate(padded(capacity));
+    }
+}
+
+template <class T, size_t D, MemType M, size_t A>
+void OwningArray<T, D, M, A>::resize(const Dims& dims)
+{
+    const size_t size = Array<T, D, M>::size();
+    resize(dims, defaultInit);
+    const size_t newSize = Array<T, D, M>::size();
+    if (newSize > size)
+    {
+        zeroElements(Array<T, D, M>::data_ + size, newSize - size);
+    }
+}
+
+template <class T, size_t D, MemType M, size_t A>
+void OwningArray<T, D, M, A>::resize(const Dims& dims, DefaultInit)
+{
+    grow(Array<T, D, M>::product(dims));
+    Array<T, D, M>::dims_ = dims;
+}
+
+template <class T, size_t D, MemType M, size_t A>
+void OwningArray<T, D, M, A>::shrink_to_fit()
+{
+    const size_t capacity = paddedSize();
+    if (capacity == 0)
+    {
+        deallocate(Array<T, D, M>::data_, capacity_);
+        Array<T, D, M>::data_ = nullptr;
+        capacity_ = 0;
+    }
+    else if (capacity < capacity_)
+    {
+        reallocate(capacity);
+    }
+}
+
+template <class T, size_t D, MemType M, size_t A>
+void OwningArray<T, D, M, A>::push_back(const T& value)
+    requires(D == 1 && M == MemType::Host)
+{
+    emplace_back(value);
+}
+
+template <class T, size_t D, MemType M, size_t A>
+template <class... Args>
+T& OwningArray<T, D, M, A>::emplace_back(Args&&... args)
+    requires(D == 1 && M == MemType::Host)
+{
+    // Build first: arguments may refer to elements moved by the growth
+    T value(std::forward<Args>(args)...);
+    const size_t size = Array<T, D, M>::dims_[0];
+    grow(size + 1);
+    T* element = new (Array<T, D, M>::data_ + size) T(value);
+    ++Array<T, D, M>::dims_[0];
+    return *element;
+}
+
+template <class T, size_t D, MemType M, size_t A>
+void OwningArray<T, D, M, A>::append(std::span<const T> values)
+    requires(D == 1)
+{
+    if (values.empty())
+    {
+        return;
+    }
+    const size_t size = Array<T, D, M>::dims_[0];
+    // Values may be elements of this array, which growing moves
+    const T* data = Array<T, D, M>::data_;
+    const std::less<const T*> less;
+    const bool inside = data && !less(values.data(), data) && less(values.data(), data + size);
+    grow(size + values.size());
+    if (inside)
+    {
+        values = {Array<T, D, M>::data_ + (values.data() - data), values.size()};
+    }
+    copyElements(Array<T, D, M>::data_ + size, values.data(), values.size());
+    Array<T, D, M>::dims_[0] += values.size();
+}
+
+template <class T, size_t D, MemType M, size_t A>
+void OwningArray<T, D, M, A>::grow(size_t size)
+{
+    if (size > capacity_)
+    {
+        reallocate(padded(std::max(size, 2 * capacity_)));
+    }
+}
+
+template <class T, size_t D, MemType M, size_t A>
+void OwningArray<T, D, M, A>::reallocate(size_t capacity)
+{
+    T* newData = allocate(capacity);
+    if (Array<T, D, M>::data_)
+    {
+        copyElements(newData, Array<T, D, M>::data_, Array<T, D, M>::size());
+        deallocate(Array<T, D, M>::data_, capacity_);
+    }
+    Array<T, D, M>::data_ = newData;
+    capacity_ = capacity;
+}
+
+template <class T, size_t D, MemType M, size_t A>
+T* OwningArray<T, D, M, A>::allocate(size_t capacity)
+{
+    return static_cast<T*>(resource_->allocate(capacity * sizeof(T), A));
+}
+
+template <class T, size_t D, MemType M, size_t A>
+void OwningArray<T, D, M, A>::deallocate(T* data, size_t capacity)
+{
+    if (data)
+    {
+        resource_->deallocate(data, capacity * sizeof(T), A);
+    }
+}
+
+template <class T, size_t D, MemType M, size_t A>
+void OwningArray<T, D, M, A>::copyElements(T* destination, const T* source, size_t count)
+{
+    if constexpr (M == MemType::Host)
+    {
+        memcpy(static_cast<void*>(destination), source, count * sizeof(T));
+    }
+    else
+    {
+        copyDeviceMemory(*resource_, source, destination, count * sizeof(T));
+    }
+}
+
+template <class T, size_t D, MemType M, size_t A>
+void OwningArray<T, D, M, A>::zeroElements(T* destination, size_t count)
+{
+    if constexpr (M == MemType::Host)
+    {
+        memset(static_cast<void*>(destination), 0, count * sizeof(T));
+    }
+    else
+    {
+        zeroDeviceMemory(*resource_, destination, count * sizeof(T));
+    }
+}
+
+////////////////////////////////////////////////////////////////
+
+template <class T, size_t D, MemType M>
+StridedView<T, D, M>::StridedView(T* data, const Dims& dims)
+    : data_{data}
+    , dims_{dims}
+{
+    size_t stride = 1;
+    for (size_t d = D; d-- > 0;)
+    {
+        strides_[d] = stride;
+        stride *= dims_[d];
+    }
+}
+
+template <class T, size_t D, MemType M>
+StridedView<T, D, M>::StridedView(T* data, const Dims& dims, const Dims& strides)
+    : data_{data}
+    , dims_{dims}
+    , strides_{strides}
+{
+}
+
+template <class T, size_t D, MemType M>
+size_t StridedView<T, D, M>::size() const
+{
+    return std::accumulate(dims_.begin(), dims_.end(), size_t{1}, std::multiplies<size_t>());
+}
+
+template <class T, size_t D, MemType M>
+size_t StridedView<T, D, M>::offsetOf(const Dims& index) const
+{
+    size_t offset = 0;
+    for (size_t d = 0; d < D; ++d)
+    {
+        offset += index[d] * strides_[d];
+    }
+    return offset;
+}
+
+template <class T, size_t D, MemType M>
+bool StridedView<T, D, M>::contiguous() const
+{
+    // Strides of dimensions of size 1 never matter
+    size_t stride = 1;
+    for (size_t d = D; d-- > 0;)
+    {
+        if (dims_[d] != 1 && strides_[d] != stride)
         {
-            memcpy(newData, Array<T, D, M>::data_, Array<T, D, M>::product(Array<T, D, M>::dims_) * sizeof(T));
-            delete Array<T, D, M>::data_;
+            return false;
         }
-        Array<T, D, M>::data_ = newData;
-        capacity_ = capacity;
+        stride *= dims_[d];
     }
+    return true;
 }
 
 template <class T, size_t D, MemType M>
-void OwningArray<T, D, M>::resize(const Dims& dims)
+std::span<T> StridedView<T, D, M>::span() const
 {
-    reserve(Array<T, D, M>::product(dims));
-    Array<T, D, M>::dims_ = dims;
+    if (!contiguous())
+    {
+        throw std::runtime_error("Strided view is not contiguous");
+    }
+    return {data_, size()};
+}
+
+template <class T, size_t D, MemType M>
+StridedView<T, D - 1, M> StridedView<T, D, M>::slice(size_t dim, size_t index) const
+    requires(D > 1)
+{
+    if (dim >= D || index >= dims_[dim])
+    {
+        throw std::out_of_range("Can't slice index " + std::to_string(index) + " of dimension " + std::to_string(dim));
+    }
+    std::array<size_t, D - 1> dims;
+    std::array<size_t, D - 1> strides;
+    for (size_t d = 0, i = 0; d < D; ++d)
+    {
+        if (d != dim)
+        {
+            dims[i] = dims_[d];
+            strides[i] = strides_[d];
+            ++i;
+        }
+    }
+    return {data_ + index * strides_[dim], dims, strides};
+}
+
+template <class T, size_t D, MemType M>
+StridedView<T, D, M> StridedView<T, D, M>::subarray(const Dims& offset, const Dims& dims) const
+{
+    for (size_t d = 0; d < D; ++d)
+    {
+        if (offset[d] + dims[d] > dims_[d])
+        {
+            throw std::out_of_range("Sub-array exceeds dimension " + std::to_string(d) + ": " +
+                                    std::to_string(offset[d] + dims[d]) + " > " + std::to_string(dims_[d]));
+        }
+    }
+    return {data_ + offsetOf(offset), dims, strides_};
+}
+
+template <class T, size_t D, MemType M>
+StridedView<T, D, M> StridedView<T, D, M>::transpose() const
+{
+    Dims dims;
+    Dims strides;
+    for (size_t d = 0; d < D; ++d)
+    {
+        dims[d] = dims_[D - 1 - d];
+        strides[d] = strides_[D - 1 - d];
+    }
+    return {data_, dims, strides};
+}
+
+template <class T, size_t D, MemType M>
+StridedView<T, D, M> StridedView<T, D, M>::transpose(size_t first, size_t second) const
+{
+    if (first >= D || second >= D)
+    {
+        throw std::out_of_range("Can't transpose dimensions " + std::to_string(first) + " and " +
+                                std::to_string(second));
+    }
+    Dims dims = dims_;
+    Dims strides = strides_;
+    std::swap(dims[first], dims[second]);
+    std::swap(strides[first], strides[second]);
+    return {data_, dims, strides};
+}
+
+template <class T, size_t D, MemType M>
+template <class F>
+void StridedView<T, D, M>::forEach(F&& fn) const
+{
+    const size_t total = size();
+    if (total == 0)
+    {
+        return;
+    }
+    if (contiguous())
+    {
+        for (size_t i = 0; i < total; ++i)
+        {
+            fn(data_[i]);
+        }
+        return;
+    }
+
+    // Walk the outer dimensions, with a plain loop on each row
+    const size_t rowSize = dims_[D - 1];
+    const size_t rowStride = strides_[D - 1];
+    Dims index{};
+    for (size_t row = 0; row < total / rowSize; ++row)
+    {
+        T* first = data_ + offsetOf(index);
+        if (rowStride == 1)
+        {
+            for (size_t i = 0; i < rowSize; ++i)
+            {
+                fn(first[i]);
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < rowSize; ++i)
+            {
+                fn(first[i * rowStride]);
+            }
+        }
+        for (size_t d = D - 1; d-- > 0;)
+        {
+            if (++index[d] < dims_[d])
+            {
+                break;
+            }
+            index[d] = 0;
+        }
+    }
+}
+
+template <class T, size_t D, MemType M>
+StridedView<T, D, M>::Iterator::Iterator(const StridedView& view, size_t position)
+    : current_{view.data_}
+    , dims_{view.dims_}
+    , strides_{view.strides_}
+    , position_{position}
+    , contiguous_{view.contiguous()}
+{
+}
+
+template <class T, size_t D, MemType M>
+typename StridedView<T, D, M>::Iterator& StridedView<T, D, M>::Iterator::operator++()
+{
+    ++position_;
+    if (contiguous_)
+    {
+        ++current_;
+        return *this;
+    }
+    for (size_t d = D; d-- > 0;)
+    {
+        current_ += strides_[d];
+        if (++index_[d] < dims_[d])
+        {
+            return *this;
+        }
+        current_ -= strides_[d] * dims_[d];
+        index_[d] = 0;
+    }
+    return *this;
 }
 
 } // namespace galaxias
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "array.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace galaxias
+{
+
+/// Order in which queued requests are serviced, first come first served within a class
+enum class Priority
+{
+    /// Needed to show anything, e.g. shaders
+    Critical,
+    Normal,
+    /// Only a hint that the data will be needed
+    Prefetch,
+};
+
+namespace detail
+{
+
+/// Read the whole file into the memory returned by allocate(size in bytes)
+void readFile(const std::filesystem::path& path, const std::function<std::byte*(size_t)>& allocate);
+
+} // namespace detail
+
+/// Reads files on a pool of I/O threads with pread, so that loading overlaps with computations. Requests return a
+/// future or call back on an I/O thread once the whole file is read. The destructor completes queued requests
+class AssetLoader
+{
+public:
+    explicit AssetLoader(size_t threads = 2);
+    AssetLoader(const AssetLoader&) = delete;
+    ~AssetLoader();
+
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    /// Load the file as an array of T, failing with std::out_of_range if its size isn't a multiple of sizeof(T)
+    template <class T = std::byte>
+    std::future<Owning1DArray<T>> load(const std::filesystem::path& path, Priority priority = Priority::Normal)
+    {
+        auto promise = std::make_shared<std::promise<Owning1DArray<T>>>();
+        auto future = promise->get_future();
+        load<T>(path,
+                priority,
+                [promise](Owning1DArray<T>&& data, std::exception_ptr error)
+                {
+                    if (error)
+                    {
+                        promise->set_exception(error);
+                    }
+                    else
+                    {
+                        promise->set_value(std::move(data));
+                    }
+                });
+        return future;
+    }
+
+    /// Load the file then call callback(data, error) on an I/O thread, error being null on success. The callback must
+    /// not throw
+    template <class T = std::byte, class F>
+    void load(const std::filesystem::path& path, Priority priority, F&& callback)
+    {
+        submit(priority,
+               [path, callback = std::forward<F>(callback)]() mutable
+               {
+                   Owning1DArray<T> data;
+                   std::exception_ptr error;
+                   try
+                   {
+                       detail::readFile(path, [&](size_t bytes) { return allocate(data, bytes); });
+                   }
+                   catch (...)
+                   {
+                       error = std::current_exception();
+                   }
+                   callback(std::move(data), error);
+               });
+    }
+
+    /// Ask the kernel to read the file ahead at Prefetch priority, so that a later load finds it in the page cache
+    void prefetch(const std::filesystem::path& path);
+
+    /// Wait until every request queued so far has been serviced
+    void wait();
+
+private:
+    struct Request
+    {
+        Priority priority;
+        uint64_t sequence;
+        std::function<void()> job;
+
+        bool operator<(const Request& rhs) const
+        {
+            // Top of the priority queue is the most urgent, oldest request
+            return priority != rhs.priority ? priority > rhs.priority : sequence > rhs.sequence;
+        }
+    };
+
+    template <class T>
+    static std::byte* allocate(Owning1DArray<T>& data, size_t bytes)
+    {
+        if (bytes % sizeof(T))
+        {
+            throw std::out_of_range("Can't fill buffer with " + std::to_string(bytes) + " bytes");
+        }
+        data.resize({{bytes / sizeof(T)}}, defaultInit);
+        return reinterpret_cast<std::byte*>(data.data());
+    }
+
+    void submit(Priority priority, std::function<void()> job);
+    void work();
+
+private:
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::priority_queue<Request> requests_;
+    uint64_t sequence_;
+    size_t running_;
+    bool stop_;
+    std::vector<std::thread> threads_;
+};
+
+} // namespace galaxias
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "mapped_array.h"
+
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace galaxias
+{
+
+/// 64-bit FNV-1a hash of asset names, usable at compile time
+constexpr uint64_t assetHash(std::string_view name)
+{
+    uint64_t hash = 0xCBF29CE484222325;
+    for (char c : name)
+    {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001B3;
+    }
+    return hash;
+}
+
+namespace pack
+{
+
+static_assert(std::endian::native == std::endian::little, "Asset packs are stored little endian");
+
+/// Asset pack layout: header, index sorted by name hash, names, then blobs each starting on a 4 KiB boundary
+constexpr std::array<char, 8> magic{{'G', 'X', 'P', 'A', 'C', 'K', '\0', '\0'}};
+constexpr uint32_t version{1};
+constexpr size_t blobAlignment{4096};
+
+struct Header
+{
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t count;
+    uint64_t indexOffset;
+    uint64_t namesOffset;
+};
+
+struct Entry
+{
+    enum Flags : uint32_t
+    {
+        Checksum = 1,
+    };
+
+    uint64_t hash;
+    uint64_t offset;
+    uint64_t size;
+    uint32_t nameOffset;
+    uint32_t nameSize;
+    /// CRC-32 of the blob when flags has Checksum
+    uint32_t checksum;
+    uint32_t flags;
+};
+
+static_assert(sizeof(Header) == 32 && sizeof(Entry) == 40, "Pack structures must have no padding");
+
+/// CRC-32 (IEEE) of data
+uint32_t crc32(std::span<const std::byte> data);
+
+} // namespace pack
+
+/// Builds an asset pack in memory and writes it in one go
+class AssetPackWriter
+{
+public:
+    /// Add a blob, throws std::runtime_error on duplicate names or hash collisions
+    void add(const std::string& name, std::span<const std::byte> data, bool checksum = true);
+    /// Add the content of a file
+    void add(const std::string& name, const std::filesystem::path& path, bool checksum = true);
+
+    void write(const std::filesystem::path& path) const;
+
+private:
+    struct Blob
+    {
+        std::string name;
+        std::vector<std::byte> data;
+        bool checksum;
+    };
+
+    std::vector<Blob> blobs_;
+};
+
+/// Read-only asset pack, memory-mapped: opening costs one open and lookups are binary searches in the mapped index.
+/// Blobs are returned as views on the mapping, without reads or copies
+class AssetPack
+{
+public:
+    /// Throws std::runtime_error if the file isn't a valid pack
+    explicit AssetPack(const std::filesystem::path& path);
+
+    size_t size() const { return index_.size(); }
+    bool contains(std::string_view name) const { return find(name) != nullptr; }
+    std::vector<std::string_view> names() const;
+
+    /// Blob as an array of T, throws std::out_of_range if missing or if its size isn't a multiple of sizeof(T)
+    template <class T = std::byte>
+    ArrayView<const T, 1> get(std::string_view name) const
+    {
+        const std::span<const std::byte> blob = bytes(name);
+        if (blob.size() % sizeof(T))
+        {
+            throw std::out_of_range("Asset " + std::string{name} + " of " + std::to_string(blob.size()) +
+                                    " bytes can't be viewed as elements of " + std::to_string(sizeof(T)) + " bytes");
+        }
+        return {reinterpret_cast<const T*>(blob.data()), blob.size() / sizeof(T)};
+    }
+
+    /// Check the blob against its checksum, true if it has none
+    bool verify(std::string_view name) const;
+
+private:
+    const pack::Entry* find(std::string_view name) const;
+    std::span<const std::byte> bytes(std::string_view name) const;
+    std::string_view nameOf(const pack::Entry& entry) const;
+
+private:
+    MappedFile file_;
+    std::span<const pack::Entry> index_;
+    std::span<const char> names_;
+};
+
+} // namespace galaxias
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "array.h"
+#include "mapped_array.h"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace galaxias
+{
+
+/// 128-bit content hash identifying derived data: the generator name and version, then every input
+class CacheKey
+{
+public:
+    CacheKey(std::string_view generator, uint32_t version);
+
+    CacheKey& add(std::span<const std::byte> bytes);
+    CacheKey& add(std::string_view text) { return add(std::as_bytes(std::span{text})); }
+    /// C strings and literals are hashed as text, without the terminating null
+    CacheKey& add(const char* text) { return add(std::string_view{text}); }
+    /// Numbers by value. Pointers and structs are not accepted: their bytes hold addresses or padding
+    template <class T>
+        requires(std::is_arithmetic_v<T> || std::is_enum_v<T>)
+    CacheKey& add(const T& value)
+    {
+        return add(std::as_bytes(std::span{&value, 1}));
+    }
+
+    /// 32 hexadecimal digits
+    std::string hex() const;
+
+private:
+    std::array<uint64_t, 2> state_;
+    uint64_t length_;
+};
+
+/// On-disk cache of derived data addressed by CacheKey, so warm starts skip regeneration. Values are written to a
+/// temporary file then renamed, hence appear atomically even to other processes, and are read back memory-mapped.
+/// When the cache exceeds its size bound, the least recently used values are evicted (use refreshes the file time).
+/// A value larger than the bound stays until the next store
+class DerivedCache
+{
+public:
+    /// Cache in the given folder, created if needed
+    DerivedCache(const std::filesystem::path& folder, size_t maxBytes);
+    DerivedCache(const DerivedCache&) = delete;
+
+    DerivedCache& operator=(const DerivedCache&) = delete;
+
+    /// $XDG_CACHE_HOME/galaxias, or ~/.cache/galaxias
+    static std::filesystem::path defaultFolder();
+
+    const std::filesystem::path& folder() const { return folder_; }
+    size_t maxBytes() const { return maxBytes_; }
+    /// Bytes used by all the cached values
+    size_t bytes() const;
+
+    bool contains(const CacheKey& key) const { return exists(pathOf(key)); }
+
+    /// Cached value, if any
+    template <class T>
+    std::optional<MappedArray<const T>> find(const CacheKey& key)
+    {
+        const auto path = pathOf(key);
+        if (!touch(path))
+        {
+            return std::nullopt;
+        }
+        return MappedArray<const T>{path};
+    }
+
+    /// Store a value, replacing any previous one, and return it mapped from the cache
+    template <class T>
+    MappedArray<const T> store(const CacheKey& key, std::span<const T> values)
+    {
+        write(key, std::as_bytes(values));
+        return MappedArray<const T>{pathOf(key)};
+    }
+
+    /// Cached value, or generate() stored then returned. generate returns a contiguous range of T
+    template <class T, class F>
+    MappedArray<const T> findOrCreate(const CacheKey& key, F&& generate)
+    {
+        if (auto value = find<T>(key))
+        {
+            return std::move(*value);
+        }
+        const auto values = generate();
+        return store(key, std::span<const T>{values.data(), values.size()});
+    }
+
+    /// Remove every cached value
+    void clear();
+
+private:
+    std::filesystem::path pathOf(const CacheKey& key) const;
+    /// Mark the value as used, false if it isn't cached
+    bool touch(const std::filesystem::path& path) const;
+    void write(const CacheKey& key, std::span<const std::byte> bytes);
+    /// Remove the least recently used values until within the size bound, except the given one
+    void evict(const std::filesystem::path& keep);
+
+private:
+    std::filesystem::path folder_;
+    size_t maxBytes_;
+    std::mutex mutex_;
+};
+
+} // namespace galaxias
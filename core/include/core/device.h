@@ -0,0 +1,126 @@
+#pragma once
+
+#include "array.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory_resource>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+namespace galaxias
+{
+
+/// Point in a device's transfer queue. Fences are signalled in submission order; the default one is always signalled
+struct Fence
+{
+    uint64_t value{0};
+};
+
+/// Device memory and transfer queue. Device memory is allocated through the memory resource interface, so device
+/// arrays are OwningArray<T, D, MemType::Device> built on a device. Their elements are only reached through copies
+class Device : public std::pmr::memory_resource
+{
+public:
+    /// Queue a copy of bytes from source to destination (host or device memory), run after all the copies queued
+    /// before. Source and destination must stay valid until the returned fence is signalled
+    virtual Fence copy(const std::byte* source, std::byte* destination, size_t bytes) = 0;
+
+    virtual bool signalled(Fence fence) const = 0;
+    virtual void wait(Fence fence) const = 0;
+};
+
+/// Device emulated on the host: device memory is host memory, copies run in order on a transfer thread. Lets the
+/// transfer layer run and be tested on machines without GPU
+class HostDevice : public Device
+{
+public:
+    HostDevice();
+    HostDevice(const HostDevice&) = delete;
+    /// Completes the queued copies
+    ~HostDevice() override;
+
+    HostDevice& operator=(const HostDevice&) = delete;
+
+    Fence copy(const std::byte* source, std::byte* destination, size_t bytes) override;
+    bool signalled(Fence fence) const override;
+    void wait(Fence fence) const override;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    void transfer();
+
+private:
+    struct Copy
+    {
+        const std::byte* source;
+        std::byte* destination;
+        size_t bytes;
+    };
+
+    mutable std::mutex mutex_;
+    mutable std::condition_variable changed_;
+    std::deque<Copy> copies_;
+    uint64_t submitted_;
+    uint64_t completed_;
+    bool stop_;
+    std::thread thread_;
+};
+
+/// Persistent host buffer used as a ring to stage uploads to a device. Each upload takes the next free region, which
+/// is reused once the copy's fence is signalled: callers only block when the whole ring is in flight, so per-frame
+/// uploads (e.g. double-buffered instance data) overlap with the transfers of previous frames
+class StagingRing
+{
+public:
+    StagingRing(Device& device, size_t capacity);
+
+    size_t capacity() const { return buffer_.size(); }
+    /// Bytes of the ring (padded to cache lines) still waiting for their copy to complete
+    size_t inFlight();
+
+    /// Copy bytes to device memory through the ring. Uploads larger than the ring are split in several copies
+    Fence upload(std::span<const std::byte> data, std::byte* destination);
+
+    /// Copy elements into a device array, starting at the given element
+    template <class T, size_t D>
+    Fence upload(std::type_identity_t<std::span<const T>> data,
+                 Array<T, D, MemType::Device>& destination,
+                 size_t first = 0)
+    {
+        if (first + data.size() > destination.size())
+        {
+            throw std::out_of_range("Can't upload " + std::to_string(data.size()) + " elements at " +
+                                    std::to_string(first) + " in an array of " + std::to_string(destination.size()));
+        }
+        return upload(std::as_bytes(data), reinterpret_cast<std::byte*>(destination.data() + first));
+    }
+
+private:
+    struct Region
+    {
+        size_t offset;
+        size_t bytes;
+        Fence fence;
+    };
+
+    /// Offset of a free region of the given bytes, waiting for copies in flight if needed
+    size_t reserve(size_t bytes);
+
+private:
+    Device& device_;
+    Owning1DArray<std::byte> buffer_;
+    size_t head_;
+    std::deque<Region> regions_;
+};
+
+} // namespace galaxias
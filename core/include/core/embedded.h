@@ -0,0 +1,35 @@
+#pragma once
+
+#include "array.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace galaxias
+{
+
+/// Resources embedded in the binaries at build time by embed_resources() (cmake/EmbedResources.cmake). They are stored
+/// as 64-byte aligned constexpr arrays of little-endian 32-bit words, zero-padded, so that accessing them involves no
+/// I/O nor copy
+class EmbeddedResources
+{
+public:
+    static bool contains(std::string_view name);
+    static std::vector<std::string_view> names();
+
+    /// Words of the resource, throws std::out_of_range if it isn't embedded
+    static ArrayView<const uint32_t, 1> words(std::string_view name);
+    /// Exact bytes of the resource, throws std::out_of_range if it isn't embedded
+    static std::span<const std::byte> bytes(std::string_view name);
+};
+
+/// Registers an embedded resource when constructed, for the sources generated by embed_resources()
+struct EmbeddedRegistration
+{
+    EmbeddedRegistration(std::string_view name, const uint32_t* words, size_t bytes);
+};
+
+} // namespace galaxias
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "array.h"
+#include "embedded.h"
 
 #include <cstdint>
 #include <filesystem>
@@ -58,7 +58,8 @@ public:
         DirectVertex,
         DirectFragment,
     };
-    static Owning1DArray<uint32_t> loadShader(ShaderType type);
+    /// SPIR-V code embedded at build time (see GALAXIAS_SHADER_DIR), throws std::out_of_range if not embedded
+    static ArrayView<const uint32_t, 1> loadShader(ShaderType type);
 };
 
 } // namespace galaxias
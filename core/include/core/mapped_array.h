@@ -0,0 +1,115 @@
+#pragma once
+
+#include "array.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace galaxias
+{
+
+/// RAII mapping of a whole file in memory
+class MappedFile
+{
+public:
+    enum class Mode
+    {
+        /// Pages are shared with every process mapping the file, writing is not allowed
+        ReadOnly,
+        /// Pages are shared until written to, writes are private and never reach the file
+        CopyOnWrite,
+    };
+
+    /// Access pattern hint for the kernel's read-ahead and paging
+    enum class Access
+    {
+        Normal,
+        Sequential,
+        Random,
+        /// Start reading the whole file now
+        WillNeed,
+    };
+
+    MappedFile(const std::filesystem::path& path, Mode mode = Mode::ReadOnly, Access access = Access::Normal);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) noexcept;
+    ~MappedFile();
+
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) noexcept;
+
+    std::byte* data() const { return data_; }
+    size_t bytes() const { return bytes_; }
+    Mode mode() const { return mode_; }
+
+    void advise(Access access) const;
+
+private:
+    void unmap();
+
+private:
+    std::byte* data_;
+    size_t bytes_;
+    Mode mode_;
+};
+
+/// File presented as an array without copying. MappedArray<const T, D> maps the file read-only, MappedArray<T, D>
+/// maps it copy-on-write: elements can be modified in memory but the file is left untouched
+template <class T, size_t D = 1>
+class MappedArray : public ArrayView<T, D>
+{
+public:
+    using Dims = typename ArrayView<T, D>::Dims;
+
+    /// Whole file as a 1D array, throws std::out_of_range if its size isn't a multiple of the element size
+    MappedArray(const std::filesystem::path& path, MappedFile::Access access = MappedFile::Access::Normal)
+        requires(D == 1)
+        : MappedArray(MappedFile{path, mode, access})
+    {
+        if (file_.bytes() % sizeof(T))
+        {
+            throw std::out_of_range("Can't map " + std::to_string(file_.bytes()) + " bytes on elements of " +
+                                    std::to_string(sizeof(T)) + " bytes");
+        }
+        this->dims_ = {{file_.bytes() / sizeof(T)}};
+    }
+
+    /// Array of the given dims starting at offset bytes in the file, throws std::out_of_range if it doesn't fit or
+    /// isn't aligned
+    MappedArray(const std::filesystem::path& path,
+                const Dims& dims,
+                size_t offset = 0,
+                MappedFile::Access access = MappedFile::Access::Normal)
+        : MappedArray(MappedFile{path, mode, access})
+    {
+        const size_t bytes = ArrayView<T, D>::product(dims) * sizeof(T);
+        if (offset % alignof(T) || offset + bytes > file_.bytes())
+        {
+            throw std::out_of_range("Can't map " + std::to_string(bytes) + " bytes at offset " +
+                                    std::to_string(offset) + " of a " + std::to_string(file_.bytes()) +
+                                    " bytes file");
+        }
+        this->data_ = reinterpret_cast<T*>(file_.data() + offset);
+        this->dims_ = dims;
+    }
+
+    const MappedFile& file() const { return file_; }
+
+private:
+    static constexpr MappedFile::Mode mode{std::is_const_v<T> ? MappedFile::Mode::ReadOnly
+                                                               : MappedFile::Mode::CopyOnWrite};
+
+    MappedArray(MappedFile&& file)
+        : ArrayView<T, D>(reinterpret_cast<T*>(file.data()), Dims{})
+        , file_{std::move(file)}
+    {
+    }
+
+private:
+    MappedFile file_;
+};
+
+} // namespace galaxias
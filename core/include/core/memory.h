@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+
+namespace galaxias
+{
+
+/// Memory resource forwarding to an upstream one while counting what goes through it, to see how much each subsystem
+/// allocates. Thread-safe as long as the upstream resource is
+class StatisticsResource : public std::pmr::memory_resource
+{
+public:
+    struct Statistics
+    {
+        size_t allocations;
+        size_t deallocations;
+        /// Bytes currently allocated, and highest value reached
+        size_t bytes;
+        size_t peakBytes;
+        /// Bytes allocated over the whole lifetime
+        size_t totalBytes;
+    };
+
+    explicit StatisticsResource(std::string name,
+                                std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+    const std::string& name() const { return name_; }
+    std::pmr::memory_resource* upstream() const { return upstream_; }
+    Statistics statistics() const;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+    std::string name_;
+    std::pmr::memory_resource* upstream_;
+    std::atomic<size_t> allocations_;
+    std::atomic<size_t> deallocations_;
+    std::atomic<size_t> bytes_;
+    std::atomic<size_t> peakBytes_;
+    std::atomic<size_t> totalBytes_;
+};
+
+/// Memory resource mapping large blocks directly, aligned on and advised for transparent huge pages, which cuts TLB
+/// misses when streaming through big buffers. Smaller blocks go to the upstream resource. Thread-safe
+class HugePageResource : public std::pmr::memory_resource
+{
+public:
+    static constexpr size_t hugePageSize{size_t{2} << 20};
+
+    /// Blocks of at least threshold bytes are mapped
+    explicit HugePageResource(size_t threshold = hugePageSize,
+                              std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+    size_t threshold() const { return threshold_; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    bool mapped(size_t bytes, size_t alignment) const;
+
+private:
+    size_t threshold_;
+    std::pmr::memory_resource* upstream_;
+};
+
+} // namespace galaxias
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "array.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace galaxias
+{
+
+/// Bytes handled per task by the array algorithms: a share of L2 cache, large enough to amortise scheduling
+constexpr size_t parallelChunkBytes{size_t{256} << 10};
+
+enum class Reduction
+{
+    /// Chunks only depend on the array dims and are combined in order: same result for any number of threads
+    Deterministic,
+    /// Chunks are combined as they complete
+    Unordered,
+};
+
+namespace detail
+{
+
+/// Elements per chunk when splitting along the outermost dimension: whole outer slices, about parallelChunkBytes
+template <class T, size_t D, MemType M>
+size_t chunkElements(const Array<T, D, M>& array)
+{
+    const size_t inner = array.dims()[0] ? array.size() / array.dims()[0] : 1;
+    const size_t slices = std::max<size_t>(1, parallelChunkBytes / std::max<size_t>(1, inner * sizeof(T)));
+    return std::max<size_t>(1, slices * inner);
+}
+
+} // namespace detail
+
+/// Call fn(begin, end) on consecutive ranges of at most grain indices covering [0, count), on the pool
+template <class F>
+void parallelFor(size_t count, size_t grain, const F& fn, ThreadPool& pool = ThreadPool::global())
+{
+    grain = std::max<size_t>(1, grain);
+    pool.run((count + grain - 1) / grain,
+             [&](size_t chunk)
+             {
+                 const size_t begin = chunk * grain;
+                 fn(begin, std::min(count, begin + grain));
+             });
+}
+
+/// Call fn(element) on each element of the array, split along the outermost dimension in cache-sized chunks
+template <class T, size_t D, MemType M, class F>
+void parallelFor(Array<T, D, M>& array, const F& fn, ThreadPool& pool = ThreadPool::global())
+{
+    T* data = array.data();
+    parallelFor(
+        array.size(),
+        detail::chunkElements(array),
+        [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                fn(data[i]);
+            }
+        },
+        pool);
+}
+
+template <class T, size_t D, MemType M, class F>
+void parallelFor(const Array<T, D, M>& array, const F& fn, ThreadPool& pool = ThreadPool::global())
+{
+    const T* data = array.data();
+    parallelFor(
+        array.size(),
+        detail::chunkElements(array),
+        [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                fn(data[i]);
+            }
+        },
+        pool);
+}
+
+/// Reduce the array: each chunk accumulates its elements as value = accumulate(value, element) starting from identity,
+/// then chunk values are merged with combine(value, value)
+template <class R, class T, size_t D, MemType M, class Accumulate, class Combine>
+R parallelReduce(const Array<T, D, M>& array,
+                 const R& identity,
+                 const Accumulate& accumulate,
+                 const Combine& combine,
+                 Reduction reduction = Reduction::Deterministic,
+                 ThreadPool& pool = ThreadPool::global())
+{
+    const T* data = array.data();
+    const size_t grain = detail::chunkElements(array);
+    const auto reduce = [&](size_t begin, size_t end)
+    {
+        R value = identity;
+        for (size_t i = begin; i < end; ++i)
+        {
+            value = accumulate(value, data[i]);
+        }
+        return value;
+    };
+
+    if (reduction == Reduction::Deterministic)
+    {
+        std::vector<std::optional<R>> partials((array.size() + grain - 1) / grain);
+        parallelFor(
+            array.size(), grain, [&](size_t begin, size_t end) { partials[begin / grain] = reduce(begin, end); }, pool);
+        R result = identity;
+        for (const auto& partial : partials)
+        {
+            result = combine(result, *partial);
+        }
+        return result;
+    }
+
+    std::mutex mutex;
+    R result = identity;
+    parallelFor(
+        array.size(),
+        grain,
+        [&](size_t begin, size_t end)
+        {
+            R value = reduce(begin, end);
+            std::lock_guard lock{mutex};
+            result = combine(result, value);
+        },
+        pool);
+    return result;
+}
+
+/// Call fn(tile, offset) on views of at most the given tile dims covering the view, offset being the first index of
+/// each tile, in row-major order of tiles. Tile dims of 0 count as 1
+template <class T, size_t D, MemType M, class F>
+void forEachTile(const StridedView<T, D, M>& view, std::array<size_t, D> tile, const F& fn)
+{
+    std::array<size_t, D> tiles;
+    size_t count = 1;
+    for (size_t d = 0; d < D; ++d)
+    {
+        tile[d] = std::max<size_t>(1, tile[d]);
+        tiles[d] = (view.dims()[d] + tile[d] - 1) / tile[d];
+        count *= tiles[d];
+    }
+    for (size_t t = 0; t < count; ++t)
+    {
+        std::array<size_t, D> offset;
+        std::array<size_t, D> dims;
+        size_t remainder = t;
+        for (size_t d = D; d-- > 0;)
+        {
+            offset[d] = remainder % tiles[d] * tile[d];
+            dims[d] = std::min(tile[d], view.dims()[d] - offset[d]);
+            remainder /= tiles[d];
+        }
+        fn(view.subarray(offset, dims), offset);
+    }
+}
+
+/// Parallel forEachTile, one task per slab of tiles along the outermost dimension
+template <class T, size_t D, MemType M, class F>
+void parallelTiles(const StridedView<T, D, M>& view,
+                   const std::array<size_t, D>& tile,
+                   const F& fn,
+                   ThreadPool& pool = ThreadPool::global())
+{
+    const size_t outer = std::max<size_t>(1, tile[0]);
+    pool.run((view.dims()[0] + outer - 1) / outer,
+             [&](size_t slab)
+             {
+                 std::array<size_t, D> offset{};
+                 std::array<size_t, D> dims = view.dims();
+                 offset[0] = slab * outer;
+                 dims[0] = std::min(outer, view.dims()[0] - offset[0]);
+                 forEachTile(view.subarray(offset, dims),
+                             tile,
+                             [&](const StridedView<T, D, M>& t, std::array<size_t, D> tileOffset)
+                             {
+                                 tileOffset[0] += offset[0];
+                                 fn(t, tileOffset);
+                             });
+             });
+}
+
+} // namespace galaxias
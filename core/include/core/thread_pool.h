@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace galaxias
+{
+
+/// Work-stealing thread pool. Each worker takes tasks from the front of its own queue and, once empty, steals from the
+/// back of the others. Threads waiting on a batch help running it, so batches may be nested
+class ThreadPool
+{
+public:
+    explicit ThreadPool(size_t threads = std::thread::hardware_concurrency());
+    ThreadPool(const ThreadPool&) = delete;
+    ~ThreadPool();
+
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Number of worker threads (the calling thread also works while waiting)
+    size_t threads() const { return workers_.size(); }
+
+    /// Call fn(0), ..., fn(count - 1) and wait for all of them. The first exception thrown by a task is rethrown
+    void run(size_t count, const std::function<void(size_t)>& fn);
+
+    /// Pool shared by the whole process, with one worker per hardware thread
+    static ThreadPool& global();
+
+private:
+    struct Batch
+    {
+        const std::function<void(size_t)>* fn;
+        std::atomic<size_t> remaining;
+        std::mutex errorMutex;
+        std::exception_ptr error;
+    };
+
+    struct Task
+    {
+        Batch* batch;
+        size_t index;
+    };
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void work(size_t worker);
+    /// Pop a task from the given queue first, then steal from the others
+    bool take(size_t first, Task& task);
+    void execute(const Task& task);
+
+private:
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<size_t> queued_;
+    std::atomic<size_t> next_;
+    std::mutex sleepMutex_;
+    /// Signals new tasks and finished batches
+    std::condition_variable wake_;
+    bool stop_;
+};
+
+} // namespace galaxias
@@ -4,9 +4,26 @@ set(objects_name ${library_name}_object)
 set(library_src
     include/${library_name}/array.h
     include/${library_name}/array.inl
+    include/${library_name}/asset_loader.h
+    include/${library_name}/asset_pack.h
+    include/${library_name}/cache.h
+    include/${library_name}/device.h
+    include/${library_name}/embedded.h
     include/${library_name}/files.h
+    include/${library_name}/mapped_array.h
+    include/${library_name}/memory.h
+    include/${library_name}/parallel.h
+    include/${library_name}/thread_pool.h
 
+    src/asset_loader.cpp
+    src/asset_pack.cpp
+    src/cache.cpp
+    src/device.cpp
+    src/embedded.cpp
     src/files.cpp
+    src/mapped_array.cpp
+    src/thread_pool.cpp
+    src/memory.cpp
 )
 
 # Trick to show the file sources.cmake in the IDE
@@ -0,0 +1,148 @@
+#include <core/asset_loader.h>
+
+#include <cerrno>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace galaxias
+{
+
+namespace
+{
+
+/// File descriptor closed on scope exit
+class File
+{
+public:
+    File(const std::filesystem::path& path)
+        : fd_{open(path.c_str(), O_RDONLY | O_CLOEXEC)}
+    {
+        if (fd_ < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "Can't open " + path.string());
+        }
+    }
+    File(const File&) = delete;
+    ~File() { close(fd_); }
+
+    File& operator=(const File&) = delete;
+
+    int fd() const { return fd_; }
+
+private:
+    int fd_;
+};
+
+} // namespace
+
+namespace detail
+{
+
+void readFile(const std::filesystem::path& path, const std::function<std::byte*(size_t)>& allocate)
+{
+    const File file{path};
+    struct stat status;
+    if (fstat(file.fd(), &status) != 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "Can't stat " + path.string());
+    }
+    const size_t size = static_cast<size_t>(status.st_size);
+    std::byte* data = allocate(size);
+    posix_fadvise(file.fd(), 0, 0, POSIX_FADV_SEQUENTIAL);
+    for (size_t done = 0; done < size;)
+    {
+        const ssize_t bytes = pread(file.fd(), data + done, size - done, static_cast<off_t>(done));
+        if (bytes < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (bytes <= 0)
+        {
+            throw std::system_error(bytes < 0 ? errno : EIO, std::generic_category(), "Can't read " + path.string());
+        }
+        done += static_cast<size_t>(bytes);
+    }
+}
+
+} // namespace detail
+
+AssetLoader::AssetLoader(size_t threads)
+    : sequence_{0}
+    , running_{0}
+    , stop_{false}
+{
+    for (size_t i = 0; i < std::max<size_t>(1, threads); ++i)
+    {
+        threads_.emplace_back([this]() { work(); });
+    }
+}
+
+AssetLoader::~AssetLoader()
+{
+    {
+        std::lock_guard lock{mutex_};
+        stop_ = true;
+    }
+    changed_.notify_all();
+    for (auto& thread : threads_)
+    {
+        thread.join();
+    }
+}
+
+void AssetLoader::prefetch(const std::filesystem::path& path)
+{
+    submit(Priority::Prefetch,
+           [path]()
+           {
+               // Only a hint: missing files will fail when actually loaded
+               const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+               if (fd >= 0)
+               {
+                   posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+                   close(fd);
+               }
+           });
+}
+
+void AssetLoader::wait()
+{
+    std::unique_lock lock{mutex_};
+    changed_.wait(lock, [&]() { return requests_.empty() && running_ == 0; });
+}
+
+void AssetLoader::submit(Priority priority, std::function<void()> job)
+{
+    {
+        std::lock_guard lock{mutex_};
+        requests_.push({priority, sequence_++, std::move(job)});
+    }
+    changed_.notify_all();
+}
+
+void AssetLoader::work()
+{
+    std::unique_lock lock{mutex_};
+    while (true)
+    {
+        // Service what is queued before stopping
+        changed_.wait(lock, [&]() { return stop_ || !requests_.empty(); });
+        if (requests_.empty())
+        {
+            return;
+        }
+        const auto job = requests_.top().job;
+        requests_.pop();
+        ++running_;
+        lock.unlock();
+        job();
+        lock.lock();
+        --running_;
+        changed_.notify_all();
+    }
+}
+
+} // namespace galaxias
@@ -0,0 +1,223 @@
+#include <core/asset_pack.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace galaxias
+{
+
+namespace pack
+{
+
+namespace
+{
+
+constexpr std::array<uint32_t, 256> crcTable()
+{
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k)
+        {
+            c = c & 1 ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+        }
+        table[i] = c;
+    }
+    return table;
+}
+
+constexpr std::array<uint32_t, 256> crcLookup = crcTable();
+
+} // namespace
+
+uint32_t crc32(std::span<const std::byte> data)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    for (std::byte b : data)
+    {
+        crc = crcLookup[(crc ^ static_cast<uint8_t>(b)) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFF;
+}
+
+} // namespace pack
+
+namespace
+{
+
+size_t alignUp(size_t offset, size_t alignment) { return (offset + alignment - 1) / alignment * alignment; }
+
+} // namespace
+
+void AssetPackWriter::add(const std::string& name, std::span<const std::byte> data, bool checksum)
+{
+    const uint64_t hash = assetHash(name);
+    for (const auto& blob : blobs_)
+    {
+        if (assetHash(blob.name) == hash)
+        {
+            throw std::runtime_error(blob.name == name ? "Duplicate asset " + name
+                                                       : "Assets " + name + " and " + blob.name + " collide");
+        }
+    }
+    blobs_.push_back({name, {data.begin(), data.end()}, checksum});
+}
+
+void AssetPackWriter::add(const std::string& name, const std::filesystem::path& path, bool checksum)
+{
+    std::ifstream ifs{path, std::ios::binary};
+    if (!ifs)
+    {
+        throw std::runtime_error("Can't read " + path.string());
+    }
+    const std::vector<char> content{std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{}};
+    add(name, std::as_bytes(std::span{content}), checksum);
+}
+
+void AssetPackWriter::write(const std::filesystem::path& path) const
+{
+    std::vector<const Blob*> sorted;
+    for (const auto& blob : blobs_)
+    {
+        sorted.push_back(&blob);
+    }
+    std::sort(sorted.begin(),
+              sorted.end(),
+              [](const Blob* a, const Blob* b) { return assetHash(a->name) < assetHash(b->name); });
+
+    pack::Header header{pack::magic, pack::version, static_cast<uint32_t>(sorted.size()), sizeof(pack::Header), 0};
+    header.namesOffset = header.indexOffset + sorted.size() * sizeof(pack::Entry);
+
+    std::vector<pack::Entry> index;
+    std::string names;
+    size_t offset = header.namesOffset;
+    for (const Blob* blob : sorted)
+    {
+        offset += blob->name.size();
+    }
+    for (const Blob* blob : sorted)
+    {
+        offset = alignUp(offset, pack::blobAlignment);
+        const uint32_t checksum = blob->checksum ? pack::crc32(blob->data) : 0;
+        index.push_back({assetHash(blob->name),
+                         offset,
+                         blob->data.size(),
+                         static_cast<uint32_t>(names.size()),
+                         static_cast<uint32_t>(blob->name.size()),
+                         checksum,
+                         blob->checksum ? pack::Entry::Checksum : 0u});
+        names += blob->name;
+        offset += blob->data.size();
+    }
+
+    std::ofstream ofs{path, std::ios::binary};
+    if (!ofs)
+    {
+        throw std::runtime_error("Can't write " + path.string());
+    }
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    ofs.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(pack::Entry));
+    ofs.write(names.data(), names.size());
+    const std::vector<char> padding(pack::blobAlignment, 0);
+    for (size_t i = 0; i < sorted.size(); ++i)
+    {
+        ofs.write(padding.data(), index[i].offset - ofs.tellp());
+        ofs.write(reinterpret_cast<const char*>(sorted[i]->data.data()), sorted[i]->data.size());
+    }
+    if (!ofs)
+    {
+        throw std::runtime_error("Can't write " + path.string());
+    }
+}
+
+////////////////////////////////////////////////////////////////
+
+AssetPack::AssetPack(const std::filesystem::path& path)
+    : file_{path, MappedFile::Mode::ReadOnly, MappedFile::Access::Random}
+{
+    const auto invalid = [&](const std::string& reason)
+    { return std::runtime_error("Invalid asset pack " + path.string() + ": " + reason); };
+
+    if (file_.bytes() < sizeof(pack::Header))
+    {
+        throw invalid("too small");
+    }
+    pack::Header header;
+    memcpy(&header, file_.data(), sizeof(header));
+    if (header.magic != pack::magic || header.version != pack::version)
+    {
+        throw invalid("wrong magic or version");
+    }
+    // Written as subtractions, so that corrupt offsets can't wrap around
+    const auto fits = [](uint64_t offset, uint64_t size, uint64_t bytes)
+    { return offset <= bytes && size <= bytes - offset; };
+    if (header.indexOffset % alignof(pack::Entry) || header.namesOffset > file_.bytes() ||
+        header.indexOffset > header.namesOffset ||
+        header.count > (header.namesOffset - header.indexOffset) / sizeof(pack::Entry))
+    {
+        throw invalid("index out of the file");
+    }
+    index_ = {reinterpret_cast<const pack::Entry*>(file_.data() + header.indexOffset), header.count};
+    names_ = {reinterpret_cast<const char*>(file_.data() + header.namesOffset), file_.bytes() - header.namesOffset};
+    for (size_t i = 0; i < index_.size(); ++i)
+    {
+        const auto& entry = index_[i];
+        if (!fits(entry.offset, entry.size, file_.bytes()) || !fits(entry.nameOffset, entry.nameSize, names_.size()))
+        {
+            throw invalid("entry out of the file");
+        }
+        // Lookups are binary searches on the hash
+        if (i > 0 && index_[i - 1].hash > entry.hash)
+        {
+            throw invalid("index not sorted");
+        }
+    }
+}
+
+std::vector<std::string_view> AssetPack::names() const
+{
+    std::vector<std::string_view> names;
+    for (const auto& entry : index_)
+    {
+        names.push_back(nameOf(entry));
+    }
+    return names;
+}
+
+bool AssetPack::verify(std::string_view name) const
+{
+    const pack::Entry* entry = find(name);
+    if (!entry)
+    {
+        throw std::out_of_range("No asset " + std::string{name});
+    }
+    return !(entry->flags & pack::Entry::Checksum) || pack::crc32(bytes(name)) == entry->checksum;
+}
+
+const pack::Entry* AssetPack::find(std::string_view name) const
+{
+    const uint64_t hash = assetHash(name);
+    const auto it = std::lower_bound(
+        index_.begin(), index_.end(), hash, [](const pack::Entry& entry, uint64_t h) { return entry.hash < h; });
+    return it != index_.end() && it->hash == hash && nameOf(*it) == name ? &*it : nullptr;
+}
+
+std::span<const std::byte> AssetPack::bytes(std::string_view name) const
+{
+    const pack::Entry* entry = find(name);
+    if (!entry)
+    {
+        throw std::out_of_range("No asset " + std::string{name});
+    }
+    return {file_.data() + entry->offset, entry->size};
+}
+
+std::string_view AssetPack::nameOf(const pack::Entry& entry) const
+{
+    return {names_.data() + entry.nameOffset, entry.nameSize};
+}
+
+} // namespace galaxias
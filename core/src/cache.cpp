@@ -0,0 +1,197 @@
+#include <core/cache.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include <unistd.h>
+
+namespace galaxias
+{
+
+namespace
+{
+
+constexpr std::string_view extension{".bin"};
+
+/// MurmurHash3 finaliser
+uint64_t fmix64(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCD;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53;
+    return h ^ (h >> 33);
+}
+
+} // namespace
+
+CacheKey::CacheKey(std::string_view generator, uint32_t version)
+    : state_{{0xCBF29CE484222325, 0x84222325CBF29CE4}}
+    , length_{0}
+{
+    add(generator);
+    add(version);
+}
+
+CacheKey& CacheKey::add(std::span<const std::byte> bytes)
+{
+    // Two FNV-1a lanes with different primes; lengths are hashed too so that inputs can't run into each other
+    for (std::byte b : bytes)
+    {
+        state_[0] = (state_[0] ^ static_cast<uint8_t>(b)) * 0x100000001B3;
+        state_[1] = (state_[1] ^ static_cast<uint8_t>(b)) * 0x1000000000000B3;
+    }
+    const uint64_t size = bytes.size();
+    state_[0] = (state_[0] ^ size) * 0x100000001B3;
+    state_[1] = (state_[1] ^ size) * 0x1000000000000B3;
+    length_ += size;
+    return *this;
+}
+
+std::string CacheKey::hex() const
+{
+    const uint64_t first = fmix64(state_[0] ^ length_);
+    const uint64_t second = fmix64(state_[1] + first);
+    char digits[33];
+    std::snprintf(digits,
+                  sizeof(digits),
+                  "%016llx%016llx",
+                  static_cast<unsigned long long>(first),
+                  static_cast<unsigned long long>(second));
+    return digits;
+}
+
+////////////////////////////////////////////////////////////////
+
+DerivedCache::DerivedCache(const std::filesystem::path& folder, size_t maxBytes)
+    : folder_{folder}
+    , maxBytes_{maxBytes}
+{
+    create_directories(folder_);
+}
+
+std::filesystem::path DerivedCache::defaultFolder()
+{
+    if (const char* cache = std::getenv("XDG_CACHE_HOME"); cache && *cache)
+    {
+        return std::filesystem::path{cache} / "galaxias";
+    }
+    if (const char* home = std::getenv("HOME"); home && *home)
+    {
+        return std::filesystem::path{home} / ".cache" / "galaxias";
+    }
+    return std::filesystem::temp_directory_path() / "galaxias";
+}
+
+size_t DerivedCache::bytes() const
+{
+    size_t total = 0;
+    for (const auto& entry : std::filesystem::directory_iterator{folder_})
+    {
+        if (entry.path().extension() == extension)
+        {
+            total += entry.file_size();
+        }
+    }
+    return total;
+}
+
+void DerivedCache::clear()
+{
+    std::lock_guard lock{mutex_};
+    for (const auto& entry : std::filesystem::directory_iterator{folder_})
+    {
+        if (entry.path().extension() == extension)
+        {
+            std::filesystem::remove(entry.path());
+        }
+    }
+}
+
+std::filesystem::path DerivedCache::pathOf(const CacheKey& key) const
+{
+    return folder_ / (key.hex() + std::string{extension});
+}
+
+bool DerivedCache::touch(const std::filesystem::path& path) const
+{
+    std::error_code error;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+    return !error;
+}
+
+void DerivedCache::write(const CacheKey& key, std::span<const std::byte> bytes)
+{
+    static std::atomic<uint64_t> counter{0};
+    const auto path = pathOf(key);
+    // Unique among processes and threads
+    auto temporary = path;
+    temporary += "." + std::to_string(getpid()) + "." + std::to_string(counter++) + ".tmp";
+    {
+        std::ofstream ofs{temporary, std::ios::binary};
+        ofs.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        if (!ofs.flush())
+        {
+            std::filesystem::remove(temporary);
+            throw std::runtime_error("Can't write cache file " + temporary.string());
+        }
+    }
+    std::filesystem::rename(temporary, path);
+
+    std::lock_guard lock{mutex_};
+    evict(path);
+}
+
+void DerivedCache::evict(const std::filesystem::path& keep)
+{
+    struct Value
+    {
+        std::filesystem::path path;
+        std::filesystem::file_time_type used;
+        size_t bytes;
+    };
+    std::vector<Value> values;
+    size_t total = 0;
+    for (const auto& entry : std::filesystem::directory_iterator{folder_})
+    {
+        std::error_code error;
+        if (entry.path().extension() == extension)
+        {
+            const auto used = entry.last_write_time(error);
+            const size_t bytes = entry.file_size(error);
+            if (!error)
+            {
+                values.push_back({entry.path(), used, bytes});
+                total += bytes;
+            }
+        }
+    }
+    if (total <= maxBytes_)
+    {
+        return;
+    }
+
+    // Least recently used first; open mappings stay valid after removal
+    std::sort(values.begin(), values.end(), [](const Value& a, const Value& b) { return a.used < b.used; });
+    for (const auto& value : values)
+    {
+        if (total <= maxBytes_)
+        {
+            break;
+        }
+        if (value.path == keep)
+        {
+            continue;
+        }
+        std::error_code error;
+        std::filesystem::remove(value.path, error);
+        total -= value.bytes;
+    }
+}
+
+} // namespace galaxias
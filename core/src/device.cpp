@@ -0,0 +1,177 @@
+#include <core/device.h>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <vector>
+
+namespace galaxias
+{
+
+namespace
+{
+
+/// Staged copies start on cache lines
+constexpr size_t stagingAlignment{64};
+
+size_t padded(size_t bytes) { return (bytes + stagingAlignment - 1) / stagingAlignment * stagingAlignment; }
+
+Device& asDevice(std::pmr::memory_resource& resource)
+{
+    auto* device = dynamic_cast<Device*>(&resource);
+    if (!device)
+    {
+        throw std::runtime_error("Device arrays must be allocated on a Device");
+    }
+    return *device;
+}
+
+} // namespace
+
+void copyDeviceMemory(std::pmr::memory_resource& resource, const void* source, void* destination, size_t bytes)
+{
+    Device& device = asDevice(resource);
+    device.wait(device.copy(static_cast<const std::byte*>(source), static_cast<std::byte*>(destination), bytes));
+}
+
+void zeroDeviceMemory(std::pmr::memory_resource& resource, void* destination, size_t bytes)
+{
+    // Devices only copy: upload zeros
+    const std::vector<std::byte> zeros(bytes);
+    copyDeviceMemory(resource, zeros.data(), destination, bytes);
+}
+
+HostDevice::HostDevice()
+    : submitted_{0}
+    , completed_{0}
+    , stop_{false}
+    , thread_{[this]() { transfer(); }}
+{
+}
+
+HostDevice::~HostDevice()
+{
+    {
+        std::lock_guard lock{mutex_};
+        stop_ = true;
+    }
+    changed_.notify_all();
+    thread_.join();
+}
+
+Fence HostDevice::copy(const std::byte* source, std::byte* destination, size_t bytes)
+{
+    Fence fence;
+    {
+        std::lock_guard lock{mutex_};
+        copies_.push_back({source, destination, bytes});
+        fence.value = ++submitted_;
+    }
+    changed_.notify_all();
+    return fence;
+}
+
+bool HostDevice::signalled(Fence fence) const
+{
+    std::lock_guard lock{mutex_};
+    return completed_ >= fence.value;
+}
+
+void HostDevice::wait(Fence fence) const
+{
+    std::unique_lock lock{mutex_};
+    changed_.wait(lock, [&]() { return completed_ >= fence.value; });
+}
+
+void HostDevice::transfer()
+{
+    std::unique_lock lock{mutex_};
+    while (true)
+    {
+        // Drain the queue before stopping
+        changed_.wait(lock, [&]() { return stop_ || !copies_.empty(); });
+        if (copies_.empty())
+        {
+            return;
+        }
+        const Copy copy = copies_.front();
+        copies_.pop_front();
+        lock.unlock();
+        memcpy(copy.destination, copy.source, copy.bytes);
+        lock.lock();
+        ++completed_;
+        changed_.notify_all();
+    }
+}
+
+void* HostDevice::do_allocate(size_t bytes, size_t alignment)
+{
+    return ::operator new(bytes, std::align_val_t{alignment});
+}
+
+void HostDevice::do_deallocate(void* p, size_t, size_t alignment) { ::operator delete(p, std::align_val_t{alignment}); }
+
+bool HostDevice::do_is_equal(const std::pmr::memory_resource& other) const noexcept { return this == &other; }
+
+////////////////////////////////////////////////////////////////
+
+StagingRing::StagingRing(Device& device, size_t capacity)
+    : device_{device}
+    , buffer_{std::array<size_t, 1>{{capacity / stagingAlignment * stagingAlignment}}}
+    , head_{0}
+{
+    if (buffer_.size() == 0)
+    {
+        throw std::out_of_range("Staging ring needs at least " + std::to_string(stagingAlignment) + " bytes");
+    }
+}
+
+size_t StagingRing::inFlight()
+{
+    while (!regions_.empty() && device_.signalled(regions_.front().fence))
+    {
+        regions_.pop_front();
+    }
+    size_t bytes = 0;
+    for (const auto& region : regions_)
+    {
+        bytes += region.bytes;
+    }
+    return bytes;
+}
+
+Fence StagingRing::upload(std::span<const std::byte> data, std::byte* destination)
+{
+    Fence fence;
+    // Split in halves of the ring, so one piece can be filled while the previous one is copied
+    const size_t piece = std::max(stagingAlignment, capacity() / 2 / stagingAlignment * stagingAlignment);
+    for (size_t done = 0; done < data.size(); done += piece)
+    {
+        const size_t bytes = std::min(piece, data.size() - done);
+        const size_t offset = reserve(bytes);
+        memcpy(buffer_.data() + offset, data.data() + done, bytes);
+        fence = device_.copy(buffer_.data() + offset, destination + done, bytes);
+        regions_.push_back({offset, padded(bytes), fence});
+    }
+    return fence;
+}
+
+size_t StagingRing::reserve(size_t bytes)
+{
+    bytes = padded(bytes);
+    const size_t offset = head_ + bytes <= capacity() ? head_ : 0;
+    const auto overlaps = [&](const Region& region)
+    { return region.offset < offset + bytes && offset < region.offset + region.bytes; };
+
+    // Regions complete in order: waiting for the oldest until none overlaps frees the range
+    while (!regions_.empty() && (device_.signalled(regions_.front().fence) ||
+                                 std::any_of(regions_.begin(), regions_.end(), overlaps)))
+    {
+        device_.wait(regions_.front().fence);
+        regions_.pop_front();
+    }
+    head_ = offset + bytes;
+    return offset;
+}
+
+} // namespace galaxias
@@ -0,0 +1,92 @@
+#include <core/embedded.h>
+
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+namespace galaxias
+{
+
+namespace
+{
+
+struct Resource
+{
+    const uint32_t* words;
+    size_t bytes;
+};
+
+/// Registry filled during static initialisation (or when loading a library), hence behind a function
+class Registry
+{
+public:
+    static Registry& instance()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    void add(std::string_view name, const Resource& resource)
+    {
+        std::lock_guard lock{mutex_};
+        resources_[name] = resource;
+    }
+
+    const Resource* find(std::string_view name)
+    {
+        std::lock_guard lock{mutex_};
+        const auto it = resources_.find(name);
+        return it != resources_.end() ? &it->second : nullptr;
+    }
+
+    const Resource& at(std::string_view name)
+    {
+        const Resource* resource = find(name);
+        if (!resource)
+        {
+            throw std::out_of_range("No embedded resource " + std::string{name});
+        }
+        return *resource;
+    }
+
+    std::vector<std::string_view> names()
+    {
+        std::lock_guard lock{mutex_};
+        std::vector<std::string_view> names;
+        for (const auto& [name, resource] : resources_)
+        {
+            names.push_back(name);
+        }
+        return names;
+    }
+
+private:
+    std::mutex mutex_;
+    std::map<std::string_view, Resource, std::less<>> resources_;
+};
+
+} // namespace
+
+bool EmbeddedResources::contains(std::string_view name) { return Registry::instance().find(name) != nullptr; }
+
+std::vector<std::string_view> EmbeddedResources::names() { return Registry::instance().names(); }
+
+ArrayView<const uint32_t, 1> EmbeddedResources::words(std::string_view name)
+{
+    const Resource& resource = Registry::instance().at(name);
+    return {resource.words, (resource.bytes + sizeof(uint32_t) - 1) / sizeof(uint32_t)};
+}
+
+std::span<const std::byte> EmbeddedResources::bytes(std::string_view name)
+{
+    const Resource& resource = Registry::instance().at(name);
+    return {reinterpret_cast<const std::byte*>(resource.words), resource.bytes};
+}
+
+EmbeddedRegistration::EmbeddedRegistration(std::string_view name, const uint32_t* words, size_t bytes)
+{
+    Registry::instance().add(name, {words, bytes});
+}
+
+} // namespace galaxias
@@ -1,8 +1,6 @@
 #include <core/files.h>
 
-#include <array>
 #include <filesystem>
-#include <fstream>
 
 #define UUID_SYSTEM_GENERATOR 1
 #include <uuid>
@@ -10,25 +8,6 @@
 namespace galaxias
 {
 
-namespace
-{
-
-template <class T>
-void loadFile(const std::filesystem::path& path, Owning1DArray<T>& buffer)
-{
-    std::ifstream ifs{path, std::ios::binary | std::ios::ate};
-    const size_t size = ifs.tellg();
-    if (size % sizeof(T))
-    {
-        throw std::out_of_range("Can't fill buffer with " + std::to_string(size) + " bytes");
-    }
-    buffer.resize({{size / sizeof(T)}});
-    ifs.seekg(0, std::ios::beg);
-    ifs.read(reinterpret_cast<char*>(buffer.data()), size);
-}
-
-} // namespace
-
 TemporaryFolder::TemporaryFolder()
     : path_{std::filesystem::temp_directory_path() / to_string(uuids::uuid_system_generator{}())}
 {
@@ -91,13 +70,9 @@ void TemporaryFile::remove()
     path_ = "";
 }
 
-Owning1DArray<uint32_t> FilesManager::loadShader(ShaderType type)
+ArrayView<const uint32_t, 1> FilesManager::loadShader(ShaderType type)
 {
-    const auto path = std::filesystem::path{"/"} / "home" / "jrenggli" / "temp" /
-                      (std::string(type == ShaderType::DirectVertex ? "vert" : "frag") + ".spv");
-    Owning1DArray<uint32_t> buffer;
-    loadFile(path, buffer);
-    return buffer;
+    return EmbeddedResources::words(type == ShaderType::DirectVertex ? "shaders/direct.vert" : "shaders/direct.frag");
 }
 
 } // namespace galaxias
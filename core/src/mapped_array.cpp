@@ -0,0 +1,116 @@
+#include <core/mapped_array.h>
+
+#include <cerrno>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace galaxias
+{
+
+namespace
+{
+
+int adviceOf(MappedFile::Access access)
+{
+    switch (access)
+    {
+    case MappedFile::Access::Sequential:
+        return MADV_SEQUENTIAL;
+    case MappedFile::Access::Random:
+        return MADV_RANDOM;
+    case MappedFile::Access::WillNeed:
+        return MADV_WILLNEED;
+    default:
+        return MADV_NORMAL;
+    }
+}
+
+} // namespace
+
+MappedFile::MappedFile(const std::filesystem::path& path, Mode mode, Access access)
+    : data_{nullptr}
+    , bytes_{0}
+    , mode_{mode}
+{
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "Can't open " + path.string());
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0)
+    {
+        const int error = errno;
+        close(fd);
+        throw std::system_error(error, std::generic_category(), "Can't stat " + path.string());
+    }
+
+    // Empty files can't be mapped, they simply give no data
+    bytes_ = static_cast<size_t>(status.st_size);
+    if (bytes_ > 0)
+    {
+        const int protection = mode == Mode::ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+        const int flags = mode == Mode::ReadOnly ? MAP_SHARED : MAP_PRIVATE;
+        void* p = mmap(nullptr, bytes_, protection, flags, fd, 0);
+        const int error = errno;
+        close(fd);
+        if (p == MAP_FAILED)
+        {
+            throw std::system_error(error, std::generic_category(), "Can't map " + path.string());
+        }
+        data_ = static_cast<std::byte*>(p);
+        advise(access);
+    }
+    else
+    {
+        close(fd);
+    }
+}
+
+MappedFile::MappedFile(MappedFile&& rhs) noexcept
+    : data_{rhs.data_}
+    , bytes_{rhs.bytes_}
+    , mode_{rhs.mode_}
+{
+    rhs.data_ = nullptr;
+    rhs.bytes_ = 0;
+}
+
+MappedFile::~MappedFile() { unmap(); }
+
+MappedFile& MappedFile::operator=(MappedFile&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        unmap();
+        std::swap(data_, rhs.data_);
+        std::swap(bytes_, rhs.bytes_);
+        mode_ = rhs.mode_;
+    }
+    return *this;
+}
+
+void MappedFile::advise(Access access) const
+{
+    // Only a hint, failures don't matter
+    if (data_)
+    {
+        madvise(data_, bytes_, adviceOf(access));
+    }
+}
+
+void MappedFile::unmap()
+{
+    if (data_)
+    {
+        munmap(data_, bytes_);
+    }
+    data_ = nullptr;
+    bytes_ = 0;
+}
+
+} // namespace galaxias
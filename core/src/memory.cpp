@@ -0,0 +1,110 @@
+#include <core/memory.h>
+
+#include <new>
+
+#include <sys/mman.h>
+
+namespace galaxias
+{
+
+namespace
+{
+
+size_t roundUp(size_t bytes, size_t alignment) { return (bytes + alignment - 1) / alignment * alignment; }
+
+} // namespace
+
+StatisticsResource::StatisticsResource(std::string name, std::pmr::memory_resource* upstream)
+    : name_{std::move(name)}
+    , upstream_{upstream}
+    , allocations_{0}
+    , deallocations_{0}
+    , bytes_{0}
+    , peakBytes_{0}
+    , totalBytes_{0}
+{
+}
+
+StatisticsResource::Statistics StatisticsResource::statistics() const
+{
+    return {allocations_, deallocations_, bytes_, peakBytes_, totalBytes_};
+}
+
+void* StatisticsResource::do_allocate(size_t bytes, size_t alignment)
+{
+    void* p = upstream_->allocate(bytes, alignment);
+    ++allocations_;
+    totalBytes_ += bytes;
+    const size_t current = bytes_ += bytes;
+    size_t peak = peakBytes_;
+    while (current > peak && !peakBytes_.compare_exchange_weak(peak, current))
+    {
+    }
+    return p;
+}
+
+void StatisticsResource::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+    upstream_->deallocate(p, bytes, alignment);
+    ++deallocations_;
+    bytes_ -= bytes;
+}
+
+bool StatisticsResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept { return this == &other; }
+
+////////////////////////////////////////////////////////////////
+
+HugePageResource::HugePageResource(size_t threshold, std::pmr::memory_resource* upstream)
+    : threshold_{threshold}
+    , upstream_{upstream}
+{
+}
+
+bool HugePageResource::mapped(size_t bytes, size_t alignment) const
+{
+    return bytes >= threshold_ && alignment <= hugePageSize;
+}
+
+void* HugePageResource::do_allocate(size_t bytes, size_t alignment)
+{
+    if (!mapped(bytes, alignment))
+    {
+        return upstream_->allocate(bytes, alignment);
+    }
+
+    // Map one extra huge page to align the block, then give back the unused head and tail
+    const size_t size = roundUp(bytes, hugePageSize);
+    void* p = mmap(nullptr, size + hugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+    {
+        throw std::bad_alloc();
+    }
+    char* first = static_cast<char*>(p);
+    char* aligned = reinterpret_cast<char*>(roundUp(reinterpret_cast<uintptr_t>(first), hugePageSize));
+    if (aligned != first)
+    {
+        munmap(first, aligned - first);
+    }
+    const size_t tail = first + size + hugePageSize - (aligned + size);
+    if (tail)
+    {
+        munmap(aligned + size, tail);
+    }
+    // Only a hint: transparent huge pages may be disabled
+    madvise(aligned, size, MADV_HUGEPAGE);
+    return aligned;
+}
+
+void HugePageResource::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+    if (!mapped(bytes, alignment))
+    {
+        upstream_->deallocate(p, bytes, alignment);
+        return;
+    }
+    munmap(p, roundUp(bytes, hugePageSize));
+}
+
+bool HugePageResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept { return this == &other; }
+
+} // namespace galaxias
@@ -0,0 +1,169 @@
+#include <core/thread_pool.h>
+
+#include <algorithm>
+
+namespace galaxias
+{
+
+ThreadPool::ThreadPool(size_t threads)
+    : queued_{0}
+    , next_{0}
+    , stop_{false}
+{
+    threads = std::max<size_t>(1, threads);
+    // One more queue for the threads calling run()
+    for (size_t i = 0; i <= threads; ++i)
+    {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    for (size_t i = 0; i < threads; ++i)
+    {
+        workers_.emplace_back([this, i]() { work(i); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock{sleepMutex_};
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::global()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::run(size_t count, const std::function<void(size_t)>& fn)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    // Consecutive tasks go to the same queue, so that workers start on neighbouring data. Counted before being
+    // published, so that a worker taking one of them never decrements the counter below 0
+    Batch batch{&fn, count, {}, nullptr};
+    const size_t queues = queues_.size();
+    const size_t first = next_++ % queues;
+    queued_ += count;
+    for (size_t q = 0; q < queues; ++q)
+    {
+        const size_t begin = count * q / queues;
+        const size_t end = count * (q + 1) / queues;
+        if (begin == end)
+        {
+            continue;
+        }
+        auto& queue = *queues_[(first + q) % queues];
+        std::lock_guard lock{queue.mutex};
+        for (size_t i = begin; i < end; ++i)
+        {
+            queue.tasks.push_back({&batch, i});
+        }
+    }
+    {
+        std::lock_guard lock{sleepMutex_};
+    }
+    wake_.notify_all();
+
+    // Help until the whole batch is done, possibly running tasks of other batches
+    Task task;
+    while (batch.remaining > 0)
+    {
+        if (take(first, task))
+        {
+            execute(task);
+        }
+        else
+        {
+            std::unique_lock lock{sleepMutex_};
+            wake_.wait(lock, [&]() { return batch.remaining == 0 || queued_ > 0; });
+        }
+    }
+
+    if (batch.error)
+    {
+        std::rethrow_exception(batch.error);
+    }
+}
+
+void ThreadPool::work(size_t worker)
+{
+    Task task;
+    while (true)
+    {
+        if (take(worker, task))
+        {
+            execute(task);
+            continue;
+        }
+        std::unique_lock lock{sleepMutex_};
+        wake_.wait(lock, [&]() { return stop_ || queued_ > 0; });
+        if (stop_)
+        {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::take(size_t first, Task& task)
+{
+    {
+        auto& own = *queues_[first];
+        std::lock_guard lock{own.mutex};
+        if (!own.tasks.empty())
+        {
+            task = own.tasks.front();
+            own.tasks.pop_front();
+            --queued_;
+            return true;
+        }
+    }
+    for (size_t q = 1; q < queues_.size(); ++q)
+    {
+        auto& other = *queues_[(first + q) % queues_.size()];
+        std::lock_guard lock{other.mutex};
+        if (!other.tasks.empty())
+        {
+            task = other.tasks.back();
+            other.tasks.pop_back();
+            --queued_;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::execute(const Task& task)
+{
+    Batch& batch = *task.batch;
+    try
+    {
+        (*batch.fn)(task.index);
+    }
+    catch (...)
+    {
+        std::lock_guard lock{batch.errorMutex};
+        if (!batch.error)
+        {
+            batch.error = std::current_exception();
+        }
+    }
+    if (--batch.remaining == 0)
+    {
+        {
+            std::lock_guard lock{sleepMutex_};
+        }
+        wake_.notify_all();
+    }
+}
+
+} // namespace galaxias
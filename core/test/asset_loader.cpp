@@ -0,0 +1,87 @@
+#include <core/asset_loader.h>
+#include <core/files.h>
+
+#include <catch2/catch.hpp>
+
+#include <fstream>
+#include <numeric>
+
+using namespace galaxias;
+
+namespace
+{
+
+std::filesystem::path writeFile(const std::filesystem::path& path, size_t count)
+{
+    std::vector<uint32_t> values(count);
+    std::iota(values.begin(), values.end(), 0);
+    std::ofstream ofs{path, std::ios::binary};
+    ofs.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(uint32_t));
+    return path;
+}
+
+} // namespace
+
+TEST_CASE("Asset loader reads files in the background")
+{
+    TemporaryFolder folder;
+    const auto small = writeFile(folder.path() / "small.bin", 10);
+    const auto large = writeFile(folder.path() / "large.bin", 1'000'000);
+
+    AssetLoader loader{2};
+    loader.prefetch(large);
+    auto first = loader.load<uint32_t>(large);
+    auto second = loader.load(small, Priority::Critical);
+    auto missing = loader.load(folder.path() / "missing.bin");
+    auto misaligned = loader.load<std::array<uint32_t, 3>>(small);
+
+    const auto values = first.get();
+    REQUIRE(values.size() == 1'000'000);
+    CHECK(values[999'999] == 999'999);
+    CHECK(second.get().size() == 40);
+    CHECK_THROWS_AS(missing.get(), std::system_error);
+    CHECK_THROWS_AS(misaligned.get(), std::out_of_range);
+
+    std::atomic<size_t> loaded{0};
+    for (size_t i = 0; i < 10; ++i)
+    {
+        loader.load<uint32_t>(small,
+                              Priority::Normal,
+                              [&](Owning1DArray<uint32_t>&& data, std::exception_ptr error)
+                              {
+                                  if (!error && data[9] == 9)
+                                  {
+                                      ++loaded;
+                                  }
+                              });
+    }
+    loader.wait();
+    CHECK(loaded == 10);
+}
+
+TEST_CASE("Asset loader services by priority")
+{
+    TemporaryFolder folder;
+    const auto path = writeFile(folder.path() / "file.bin", 10);
+
+    // A single thread, kept busy by the first request while the others queue up
+    AssetLoader loader{1};
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::mutex mutex;
+    std::vector<Priority> order;
+    loader.load(path, Priority::Normal, [&](auto&&, std::exception_ptr) { released.wait(); });
+    for (Priority priority : {Priority::Prefetch, Priority::Normal, Priority::Critical, Priority::Normal})
+    {
+        loader.load(path,
+                    priority,
+                    [&, priority](auto&&, std::exception_ptr)
+                    {
+                        std::lock_guard lock{mutex};
+                        order.push_back(priority);
+                    });
+    }
+    release.set_value();
+    loader.wait();
+    CHECK(order == std::vector<Priority>{Priority::Critical, Priority::Normal, Priority::Normal, Priority::Prefetch});
+}
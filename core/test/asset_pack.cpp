@@ -0,0 +1,129 @@
+#include <core/asset_pack.h>
+#include <core/files.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <numeric>
+
+using namespace galaxias;
+
+TEST_CASE("Asset name hash")
+{
+    static_assert(assetHash("") == 0xCBF29CE484222325);
+    CHECK(assetHash("a") == 0xAF63DC4C8601EC8C);
+    CHECK(assetHash("shaders/direct.vert") != assetHash("shaders/direct.frag"));
+
+    const std::string text{"123456789"};
+    CHECK(pack::crc32(std::as_bytes(std::span{text})) == 0xCBF43926);
+}
+
+TEST_CASE("Asset pack round trip")
+{
+    TemporaryFolder folder;
+    const auto path = folder.path() / "assets.pack";
+
+    std::vector<uint32_t> table(1000);
+    std::iota(table.begin(), table.end(), 0);
+    const std::string text{"void main() {}"};
+    {
+        const auto file = folder.path() / "text.txt";
+        std::ofstream{file} << text;
+
+        AssetPackWriter writer;
+        writer.add("tables/values", std::as_bytes(std::span{table}));
+        writer.add("shaders/direct.vert", file, false);
+        writer.add("empty", std::span<const std::byte>{});
+        CHECK_THROWS_AS(writer.add("empty", std::span<const std::byte>{}), std::runtime_error);
+        writer.write(path);
+    }
+
+    const AssetPack pack{path};
+    CHECK(pack.size() == 3);
+    CHECK(pack.contains("tables/values"));
+    CHECK_FALSE(pack.contains("tables/value"));
+    auto names = pack.names();
+    std::sort(names.begin(), names.end());
+    CHECK(names == std::vector<std::string_view>{"empty", "shaders/direct.vert", "tables/values"});
+
+    const auto values = pack.get<uint32_t>("tables/values");
+    REQUIRE(values.size() == table.size());
+    CHECK(std::equal(table.begin(), table.end(), values.data()));
+    CHECK(reinterpret_cast<uintptr_t>(values.data()) % pack::blobAlignment == 0);
+
+    const auto shader = pack.get<char>("shaders/direct.vert");
+    CHECK(std::string(shader.data(), shader.size()) == text);
+    CHECK(pack.get("empty").size() == 0);
+
+    CHECK(pack.verify("tables/values"));
+    CHECK(pack.verify("shaders/direct.vert"));
+    CHECK_THROWS_AS(pack.get("missing"), std::out_of_range);
+    using Triplet = std::array<char, 3>;
+    CHECK_THROWS_AS(pack.get<Triplet>("shaders/direct.vert"), std::out_of_range);
+
+    // Corrupted blob fails its checksum
+    std::ifstream ifs{path, std::ios::binary};
+    std::vector<char> content{std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{}};
+    const auto bytes = std::as_bytes(std::span{table});
+    const auto blob = std::search(content.begin(),
+                                  content.end(),
+                                  reinterpret_cast<const char*>(bytes.data()),
+                                  reinterpret_cast<const char*>(bytes.data() + bytes.size()));
+    REQUIRE(blob != content.end());
+    blob[100] ^= 1;
+    const auto corrupted = folder.path() / "corrupted.pack";
+    std::ofstream{corrupted, std::ios::binary}.write(content.data(), content.size());
+    CHECK_FALSE(AssetPack{corrupted}.verify("tables/values"));
+    CHECK(AssetPack{corrupted}.verify("shaders/direct.vert"));
+
+    const auto invalid = folder.path() / "invalid.pack";
+    std::ofstream{invalid} << "not a pack at all, but long enough for a header";
+    CHECK_THROWS_AS(AssetPack{invalid}, std::runtime_error);
+}
+
+TEST_CASE("Corrupt asset pack indices are rejected")
+{
+    TemporaryFolder folder;
+    const auto path = folder.path() / "assets.pack";
+    {
+        const std::vector<uint32_t> table(100, 7);
+        AssetPackWriter writer;
+        writer.add("first", std::as_bytes(std::span{table}));
+        writer.add("second", std::as_bytes(std::span{table}));
+        writer.write(path);
+    }
+    std::ifstream ifs{path, std::ios::binary};
+    const std::vector<char> content{std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{}};
+    pack::Header header;
+    memcpy(&header, content.data(), sizeof(header));
+    REQUIRE(header.count == 2);
+
+    // Rewrite the header or the first entry, then open the result
+    const auto open = [&](const std::function<void(pack::Header&, pack::Entry&, pack::Entry&)>& corrupt)
+    {
+        auto bytes = content;
+        pack::Header h;
+        std::array<pack::Entry, 2> entries;
+        memcpy(&h, bytes.data(), sizeof(h));
+        memcpy(entries.data(), bytes.data() + header.indexOffset, sizeof(entries));
+        corrupt(h, entries[0], entries[1]);
+        memcpy(bytes.data(), &h, sizeof(h));
+        memcpy(bytes.data() + header.indexOffset, entries.data(), sizeof(entries));
+        const auto corrupted = folder.path() / "corrupted.pack";
+        std::ofstream{corrupted, std::ios::binary}.write(bytes.data(), bytes.size());
+        return AssetPack{corrupted};
+    };
+
+    CHECK(open([](pack::Header&, pack::Entry&, pack::Entry&) {}).size() == 2);
+    // Sums which wrap around would pass naive bounds checks
+    CHECK_THROWS_AS(open([](pack::Header&, pack::Entry& entry, pack::Entry&) { entry.offset = ~uint64_t{0} - 10; }),
+                    std::runtime_error);
+    CHECK_THROWS_AS(open([](pack::Header&, pack::Entry& entry, pack::Entry&) { entry.nameOffset = ~uint32_t{0}; }),
+                    std::runtime_error);
+    CHECK_THROWS_AS(open([](pack::Header& h, pack::Entry&, pack::Entry&) { h.count = ~uint32_t{0}; }),
+                    std::runtime_error);
+    CHECK_THROWS_AS(open([](pack::Header&, pack::Entry& first, pack::Entry& second) { std::swap(first, second); }),
+                    std::runtime_error);
+}
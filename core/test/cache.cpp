@@ -0,0 +1,106 @@
+#include <core/cache.h>
+#include <core/files.h>
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace galaxias;
+
+TEST_CASE("Cache keys")
+{
+    const auto key = [](uint32_t version, double input) { return CacheKey{"lut", version}.add(input).hex(); };
+    CHECK(key(1, 2.) == key(1, 2.));
+    CHECK(key(1, 2.) != key(2, 2.));
+    CHECK(key(1, 2.) != key(1, 3.));
+    CHECK(key(1, 2.).size() == 32);
+    CHECK(CacheKey{"lut", 1}.hex() != CacheKey{"lux", 1}.hex());
+
+    // Inputs boundaries matter
+    CHECK(CacheKey{"g", 1}.add("ab").add("c").hex() != CacheKey{"g", 1}.add("a").add("bc").hex());
+    CHECK(CacheKey{"g", 1}.add(std::string_view{"ab"}).add(std::string_view{"c"}).hex() !=
+          CacheKey{"g", 1}.add(std::string_view{"a"}).add(std::string_view{"bc"}).hex());
+
+    // Strings are hashed by content, whatever their type or address
+    const std::string first{"a rather long input, not stored inline"};
+    const std::string second{first};
+    REQUIRE(first.c_str() != second.c_str());
+    const auto text = [](const auto& input) { return CacheKey{"g", 1}.add(input).hex(); };
+    CHECK(text(first.c_str()) == text(second.c_str()));
+    CHECK(text(first) == text(second.c_str()));
+    CHECK(text("ab") == text(std::string_view{"ab"}));
+    CHECK(text("ab") == text(std::string{"ab"}));
+}
+
+TEST_CASE("Derived cache stores and maps values")
+{
+    TemporaryFolder folder;
+    DerivedCache cache{folder.path() / "cache", 1 << 20};
+    const CacheKey key = CacheKey{"squares", 1}.add(size_t{1000});
+
+    size_t generated = 0;
+    const auto generate = [&]()
+    {
+        ++generated;
+        std::vector<uint64_t> squares(1000);
+        for (size_t i = 0; i < squares.size(); ++i)
+        {
+            squares[i] = i * i;
+        }
+        return squares;
+    };
+
+    CHECK_FALSE(cache.find<uint64_t>(key));
+    const auto first = cache.findOrCreate<uint64_t>(key, generate);
+    CHECK(generated == 1);
+    CHECK(first.size() == 1000);
+    CHECK(first[999] == 999 * 999);
+    CHECK(cache.contains(key));
+    CHECK(cache.bytes() == 8000);
+
+    // Warm start
+    DerivedCache warm{folder.path() / "cache", 1 << 20};
+    const auto second = warm.findOrCreate<uint64_t>(key, generate);
+    CHECK(generated == 1);
+    CHECK(second[500] == 250000);
+
+    cache.clear();
+    CHECK_FALSE(cache.contains(key));
+    CHECK(first[999] == 999 * 999);
+}
+
+TEST_CASE("Derived cache evicts least recently used values")
+{
+    TemporaryFolder folder;
+    DerivedCache cache{folder.path(), 3000};
+    const std::vector<char> kilo(1000, 'x');
+    const auto key = [](int i) { return CacheKey{"kilo", 1}.add(i); };
+
+    // Date the values a minute apart in store order, rather than relying on the file system's time resolution
+    const auto now = std::filesystem::file_time_type::clock::now();
+    for (int i = 0; i < 3; ++i)
+    {
+        cache.store<char>(key(i), kilo);
+        std::filesystem::last_write_time(folder.path() / (key(i).hex() + ".bin"), now - std::chrono::minutes(3 - i));
+    }
+    CHECK(cache.find<char>(key(0)));
+
+    // Key 1 is the least recently used
+    cache.store<char>(key(3), kilo);
+    CHECK(cache.contains(key(0)));
+    CHECK_FALSE(cache.contains(key(1)));
+    CHECK(cache.contains(key(2)));
+    CHECK(cache.contains(key(3)));
+    CHECK(cache.bytes() <= cache.maxBytes());
+
+    // Values larger than the bound are still returned
+    const std::vector<char> large(5000, 'y');
+    const auto stored = cache.store<char>(key(4), large);
+    CHECK(stored.size() == 5000);
+    CHECK(cache.contains(key(4)));
+}
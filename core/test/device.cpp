@@ -0,0 +1,101 @@
+#include <core/device.h>
+
+#include <catch2/catch.hpp>
+
+#include <numeric>
+#include <vector>
+
+using namespace galaxias;
+
+namespace
+{
+
+template <class T>
+std::vector<T> download(Device& device, const OwningArray<T, 1, MemType::Device>& array)
+{
+    std::vector<T> values(array.size());
+    device.wait(device.copy(reinterpret_cast<const std::byte*>(array.data()),
+                            reinterpret_cast<std::byte*>(values.data()),
+                            array.bytes()));
+    return values;
+}
+
+} // namespace
+
+TEST_CASE("Host device copies in order")
+{
+    HostDevice device;
+    CHECK(device.signalled(Fence{}));
+
+    OwningArray<int, 1, MemType::Device> array(std::array<size_t, 1>{{1000}}, &device);
+    CHECK(array.resource() == &device);
+    std::vector<int> values(1000);
+    std::iota(values.begin(), values.end(), 0);
+    const Fence first = device.copy(reinterpret_cast<const std::byte*>(values.data()),
+                                    reinterpret_cast<std::byte*>(array.data()),
+                                    array.bytes());
+    device.wait(first);
+    CHECK(device.signalled(first));
+    CHECK(download(device, array) == values);
+}
+
+TEST_CASE("Device arrays grow and copy through the device")
+{
+    HostDevice device;
+    OwningArray<int, 1, MemType::Device> array(std::array<size_t, 1>{{100}}, &device);
+    CHECK(download(device, array) == std::vector<int>(100, 0));
+
+    std::vector<int> values(100);
+    std::iota(values.begin(), values.end(), 1);
+    array.append(values);
+    array.resize({{1000}});
+    auto expected = values;
+    expected.insert(expected.begin(), 100, 0);
+    expected.resize(1000, 0);
+    CHECK(array.capacity() >= 1000);
+    CHECK(download(device, array) == expected);
+
+    const auto copy = array;
+    CHECK(copy.resource() == &device);
+    CHECK(download(device, copy) == expected);
+
+    // Device arrays need a device to copy their elements
+    OwningArray<int, 1, MemType::Device> host(std::pmr::new_delete_resource());
+    CHECK_THROWS_AS(host.resize({{10}}), std::runtime_error);
+}
+
+TEST_CASE("Staging ring uploads")
+{
+    HostDevice device;
+    StagingRing ring{device, 1000};
+    CHECK(ring.capacity() == 960);
+
+    // Larger than the ring
+    OwningArray<float, 1, MemType::Device> large(std::array<size_t, 1>{{10000}}, &device);
+    std::vector<float> values(large.size());
+    std::iota(values.begin(), values.end(), 0.f);
+    device.wait(ring.upload(values, large));
+    CHECK(ring.inFlight() == 0);
+    CHECK(download(device, large) == values);
+
+    // Double-buffered frames: fill one array while the other is uploaded
+    std::array<OwningArray<uint32_t, 1, MemType::Device>, 2> frames{
+        OwningArray<uint32_t, 1, MemType::Device>{std::array<size_t, 1>{{50}}, &device},
+        OwningArray<uint32_t, 1, MemType::Device>{std::array<size_t, 1>{{50}}, &device}};
+    std::array<Fence, 2> fences;
+    std::vector<uint32_t> instances(50);
+    for (uint32_t frame = 0; frame < 100; ++frame)
+    {
+        auto& target = frames[frame % 2];
+        device.wait(fences[frame % 2]);
+        std::fill(instances.begin(), instances.end(), frame);
+        fences[frame % 2] = ring.upload(instances, target, 0);
+        CHECK(ring.inFlight() <= ring.capacity());
+    }
+    device.wait(fences[1]);
+    CHECK(download(device, frames[0]) == std::vector<uint32_t>(50, 98));
+    CHECK(download(device, frames[1]) == std::vector<uint32_t>(50, 99));
+
+    CHECK_THROWS_AS(ring.upload(instances, frames[0], 1), std::out_of_range);
+    CHECK_THROWS_AS((StagingRing{device, 10}), std::out_of_range);
+}
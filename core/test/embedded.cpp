@@ -0,0 +1,46 @@
+#include <core/embedded.h>
+#include <core/files.h>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+
+using namespace galaxias;
+
+TEST_CASE("Embedded resources")
+{
+    REQUIRE(EmbeddedResources::contains("test/greeting.txt"));
+    const std::string greeting{"Hello, embedded world!"};
+
+    const auto bytes = EmbeddedResources::bytes("test/greeting.txt");
+    CHECK(std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size()) == greeting);
+
+    // Words are aligned and zero-padded
+    const auto words = EmbeddedResources::words("test/greeting.txt");
+    CHECK(words.size() == (greeting.size() + 3) / 4);
+    CHECK(reinterpret_cast<uintptr_t>(words.data()) % 64 == 0);
+    CHECK(words[0] == ('H' | 'e' << 8 | 'l' << 16 | 'l' << 24));
+    // "d!" then padding
+    CHECK(words[words.size() - 1] == ('d' | '!' << 8));
+
+    CHECK(EmbeddedResources::bytes("test/empty").empty());
+    CHECK(EmbeddedResources::words("test/empty").size() == 0);
+
+    const auto names = EmbeddedResources::names();
+    CHECK(std::find(names.begin(), names.end(), "test/empty") != names.end());
+    CHECK_FALSE(EmbeddedResources::contains("test/missing"));
+    CHECK_THROWS_AS(EmbeddedResources::words("test/missing"), std::out_of_range);
+}
+
+TEST_CASE("Shaders are only available once embedded")
+{
+    if (!EmbeddedResources::contains("shaders/direct.vert"))
+    {
+        CHECK_THROWS_AS(FilesManager::loadShader(FilesManager::ShaderType::DirectVertex), std::out_of_range);
+    }
+    else
+    {
+        // SPIR-V magic number
+        CHECK(FilesManager::loadShader(FilesManager::ShaderType::DirectVertex)[0] == 0x07230203);
+    }
+}
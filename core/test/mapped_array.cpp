@@ -0,0 +1,73 @@
+#include <core/files.h>
+#include <core/mapped_array.h>
+
+#include <catch2/catch.hpp>
+
+#include <fstream>
+#include <numeric>
+#include <vector>
+
+using namespace galaxias;
+
+namespace
+{
+
+template <class T>
+void writeFile(const std::filesystem::path& path, const std::vector<T>& values)
+{
+    std::ofstream ofs{path, std::ios::binary};
+    ofs.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+} // namespace
+
+TEST_CASE("Mapped arrays present files without copies")
+{
+    TemporaryFolder folder;
+    const auto path = folder.path() / "values.bin";
+    std::vector<uint32_t> values(1000);
+    std::iota(values.begin(), values.end(), 0);
+    writeFile(path, values);
+
+    // Read-only 1D
+    MappedArray<const uint32_t> array{path, MappedFile::Access::Sequential};
+    CHECK(array.file().mode() == MappedFile::Mode::ReadOnly);
+    CHECK(array.size() == values.size());
+    CHECK(array.bytes() == array.file().bytes());
+    CHECK(std::equal(values.begin(), values.end(), array.data()));
+
+    // 2D at an offset
+    MappedArray<const uint32_t, 2> table{path, {{10, 20}}, 100 * sizeof(uint32_t)};
+    CHECK(table.size() == 200);
+    CHECK(table[{{3, 4}}] == 164);
+    CHECK(table.view().column(4)[3] == 164);
+    CHECK_THROWS_AS((MappedArray<const uint32_t, 2>{path, {{10, 100}}, 1}), std::out_of_range);
+    CHECK_THROWS_AS((MappedArray<const uint32_t, 2>{path, {{10, 100}}, 4}), std::out_of_range);
+
+    // Copy-on-write leaves the file untouched
+    {
+        MappedArray<uint32_t> copy{path};
+        CHECK(copy.file().mode() == MappedFile::Mode::CopyOnWrite);
+        copy[5] = 42;
+        CHECK(copy[5] == 42);
+        CHECK(array[5] == 5);
+
+        // Moves keep the mapping
+        MappedArray<uint32_t> moved{std::move(copy)};
+        CHECK(moved[5] == 42);
+        CHECK(moved.file().bytes() == values.size() * sizeof(uint32_t));
+    }
+    MappedArray<const uint32_t> reopened{path};
+    CHECK(reopened[5] == 5);
+
+    // Sizes must match elements
+    using Triplet = std::array<uint32_t, 3>;
+    CHECK_THROWS_AS(MappedArray<const Triplet>{path}, std::out_of_range);
+    CHECK_THROWS_AS(MappedArray<const uint32_t>{folder.path() / "missing.bin"}, std::system_error);
+
+    // Empty files give empty arrays
+    writeFile(folder.path() / "empty.bin", std::vector<uint32_t>{});
+    MappedArray<const uint32_t> empty{folder.path() / "empty.bin"};
+    CHECK(empty.size() == 0);
+    CHECK(empty.data() == nullptr);
+}
@@ -0,0 +1,81 @@
+#include <core/array.h>
+#include <core/memory.h>
+
+#include <catch2/catch.hpp>
+
+#include <numeric>
+
+using namespace galaxias;
+
+TEST_CASE("Statistics resource counts allocations")
+{
+    StatisticsResource stats{"test"};
+    CHECK(stats.name() == "test");
+    {
+        Owning1DArray<double> first{&stats};
+        first.resize({{100}});
+        CHECK(first.resource() == &stats);
+        auto s = stats.statistics();
+        CHECK(s.allocations == 1);
+        CHECK(s.bytes == first.capacity() * sizeof(double));
+
+        Owning1DArray<float> second({{1000}}, &stats);
+        s = stats.statistics();
+        CHECK(s.allocations == 2);
+        CHECK(s.bytes == first.capacity() * sizeof(double) + second.capacity() * sizeof(float));
+
+        // Growing frees the old block, moves keep the resource
+        first.resize({{1000}});
+        auto moved = std::move(first);
+        CHECK(moved.resource() == &stats);
+        s = stats.statistics();
+        CHECK(s.allocations == 3);
+        CHECK(s.deallocations == 1);
+        CHECK(s.peakBytes >= s.bytes);
+
+        // So do copies, which device arrays rely on
+        const auto copy = moved;
+        CHECK(copy.resource() == &stats);
+        CHECK(stats.statistics().allocations == 4);
+    }
+    const auto s = stats.statistics();
+    CHECK(s.bytes == 0);
+    CHECK(s.allocations == s.deallocations);
+    CHECK(s.totalBytes == (104 + 1000 + 1000) * sizeof(double) + 1008 * sizeof(float));
+}
+
+TEST_CASE("Owning arrays in an arena")
+{
+    std::pmr::monotonic_buffer_resource arena;
+    StatisticsResource stats{"arena", &arena};
+    Owning1DArray<int> owner{&stats};
+    for (int i = 0; i < 1000; ++i)
+    {
+        owner.push_back(i);
+    }
+    CHECK(reinterpret_cast<uintptr_t>(owner.data()) % defaultAlignment == 0);
+    CHECK(std::accumulate(owner.data(), owner.data() + owner.size(), 0) == 999 * 1000 / 2);
+    CHECK(stats.statistics().allocations > 1);
+}
+
+TEST_CASE("Huge page resource")
+{
+    StatisticsResource upstream{"upstream"};
+    HugePageResource hugePages{HugePageResource::hugePageSize, &upstream};
+
+    // Small blocks go upstream
+    Owning1DArray<float> small({{1000}}, &hugePages);
+    CHECK(upstream.statistics().allocations == 1);
+
+    // Large ones are mapped and aligned on huge pages
+    constexpr size_t size{3 * HugePageResource::hugePageSize / sizeof(double) + 5};
+    Owning1DArray<double> large({{size}}, &hugePages);
+    CHECK(upstream.statistics().allocations == 1);
+    CHECK(reinterpret_cast<uintptr_t>(large.data()) % HugePageResource::hugePageSize == 0);
+    std::iota(large.data(), large.data() + size, 0.);
+    CHECK(large[size - 1] == static_cast<double>(size - 1));
+
+    large.push_back(1.);
+    CHECK(large[size] == 1.);
+    CHECK(large[size - 1] == static_cast<double>(size - 1));
+}
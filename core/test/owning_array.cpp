@@ -13,27 +13,30 @@ TEMPLATE_TEST_CASE("Empty owning array has nullptr", "[array]", uint8_t, int64_t
     CHECK(owner.dims() == (typename Owning1DArray<TestType>::Dims{{0}}));
 
     // Which can be reserved
+    // Capacity is padded to a whole vector
+    constexpr size_t vector = Owning1DArray<TestType>::vectorSize;
     owner.reserve(5);
     auto data = owner.data();
     CHECK(data != nullptr);
-    CHECK(owner.capacity() == 5);
+    CHECK(owner.capacity() == vector);
     CHECK(owner.size() == 0);
 
     // And resized
     owner.resize({{3}});
     CHECK(owner.data() == data);
-    CHECK(owner.capacity() == 5);
+    CHECK(owner.capacity() == vector);
     CHECK(owner.size() == 3);
+    CHECK(owner.paddedSize() == vector);
     for (size_t i = 0; i < 3; ++i)
     {
         owner[i] = static_cast<TestType>(25 + i);
     }
 
     // And resize keeps data
-    owner.resize({{7}});
+    owner.resize({{vector + 2}});
     CHECK(owner.data() != data);
-    CHECK(owner.capacity() == 7);
-    CHECK(owner.size() == 7);
+    CHECK(owner.capacity() == 2 * vector);
+    CHECK(owner.size() == vector + 2);
     for (size_t i = 0; i < 3; ++i)
     {
         CHECK(owner[i] == static_cast<TestType>(25 + i));
@@ -51,7 +54,7 @@ TEMPLATE_TEST_CASE("View on simple owning array has correct observables", "[arra
         std::iota(base.data(), base.data() + size, 0);
 
         Owning1DArray<TestType> copyCtor{base};
-        CHECK(copyCtor.capacity() == size);
+        CHECK(copyCtor.capacity() == copyCtor.paddedSize());
         CHECK(copyCtor.size() == size);
         CHECK(copyCtor.dims() == dims);
         for (size_t i = 0; i < size; ++i)
@@ -60,7 +63,7 @@ TEMPLATE_TEST_CASE("View on simple owning array has correct observables", "[arra
         }
 
         Owning1DArray<TestType> moveCtor{std::move(base)};
-        CHECK(moveCtor.capacity() == size);
+        CHECK(moveCtor.capacity() == moveCtor.paddedSize());
         CHECK(moveCtor.size() == size);
         CHECK(moveCtor.dims() == dims);
         for (size_t i = 0; i < size; ++i)
@@ -77,7 +80,7 @@ TEMPLATE_TEST_CASE("View on simple owning array has correct observables", "[arra
 
         Owning1DArray<TestType> copy;
         copy = base;
-        CHECK(copy.capacity() == size);
+        CHECK(copy.capacity() == copy.paddedSize());
         CHECK(copy.size() == size);
         CHECK(copy.dims() == dims);
         for (size_t i = 0; i < size; ++i)
@@ -87,7 +90,7 @@ TEMPLATE_TEST_CASE("View on simple owning array has correct observables", "[arra
 
         Owning1DArray<TestType> move;
         move = std::move(base);
-        CHECK(move.capacity() == size);
+        CHECK(move.capacity() == move.paddedSize());
         CHECK(move.size() == size);
         CHECK(move.dims() == dims);
         for (size_t i = 0; i < size; ++i)
@@ -96,3 +99,116 @@ TEMPLATE_TEST_CASE("View on simple owning array has correct observables", "[arra
         }
     }
 }
+
+TEMPLATE_TEST_CASE("Owning array is aligned", "[array]", uint8_t, int64_t, float, double)
+{
+    const auto aligned = [](const void* data, size_t alignment)
+    { return reinterpret_cast<uintptr_t>(data) % alignment == 0; };
+
+    Owning1DArray<TestType> owner;
+    for (size_t size : {1, 3, 17, 100, 1000})
+    {
+        owner.resize({{size}});
+        CHECK(aligned(owner.data(), defaultAlignment));
+        CHECK(owner.alignedData() == owner.data());
+        CHECK(owner.paddedSize() % Owning1DArray<TestType>::vectorSize == 0);
+        CHECK(owner.paddedSize() >= size);
+        CHECK(owner.capacity() >= owner.paddedSize());
+    }
+
+    OwningArray<TestType, 2, MemType::Host, 256> wide(std::array<size_t, 2>{{3, 5}});
+    CHECK(aligned(wide.data(), 256));
+    CHECK(wide.capacity() == 256 / sizeof(TestType));
+    auto copy = wide;
+    CHECK(aligned(copy.data(), 256));
+    CHECK(copy.dims() == wide.dims());
+}
+
+TEST_CASE("Owning array pads elements not dividing the alignment")
+{
+    struct Vec3
+    {
+        float x;
+        float y;
+        float z;
+    };
+    STATIC_REQUIRE(Owning1DArray<Vec3>::vectorSize == 16);
+    STATIC_REQUIRE(Owning1DArray<double>::vectorSize == 8);
+    STATIC_REQUIRE(OwningArray<std::array<double, 16>, 1>::vectorSize == 1);
+
+    Owning1DArray<Vec3> owner(std::array<size_t, 1>{{20}});
+    CHECK(owner.paddedSize() == 32);
+    CHECK(owner.paddedSize() * sizeof(Vec3) % defaultAlignment == 0);
+    CHECK(owner.capacity() >= owner.paddedSize());
+}
+
+TEMPLATE_TEST_CASE("Owning array appends", "[array]", uint8_t, int64_t, float, double)
+{
+    constexpr size_t vector = Owning1DArray<TestType>::vectorSize;
+    Owning1DArray<TestType> owner;
+
+    // Capacity grows geometrically
+    size_t reallocations = 0;
+    const TestType* data = owner.data();
+    for (size_t i = 0; i < 100 * vector; ++i)
+    {
+        if (i % 2)
+        {
+            owner.push_back(static_cast<TestType>(i % 100));
+        }
+        else
+        {
+            CHECK(owner.emplace_back(static_cast<TestType>(i % 100)) == static_cast<TestType>(i % 100));
+        }
+        if (owner.data() != data)
+        {
+            data = owner.data();
+            ++reallocations;
+        }
+    }
+    CHECK(owner.size() == 100 * vector);
+    CHECK(reallocations <= 8);
+    for (size_t i = 0; i < owner.size(); ++i)
+    {
+        CHECK(owner[i] == static_cast<TestType>(i % 100));
+    }
+
+    // Append a range, including from itself
+    const std::array<TestType, 3> values{{7, 8, 9}};
+    owner.append(values);
+    owner.shrink_to_fit();
+    CHECK(owner.capacity() == owner.paddedSize());
+    owner.append(std::span<const TestType>{owner.data(), owner.size()});
+    CHECK(owner.size() == 2 * (100 * vector + 3));
+    for (size_t i = 0; i < owner.size() / 2; ++i)
+    {
+        CHECK(owner[owner.size() / 2 + i] == owner[i]);
+    }
+    CHECK(owner[100 * vector + 2] == static_cast<TestType>(9));
+
+    // Self reference survives reallocation
+    owner.shrink_to_fit();
+    owner.resize({{owner.capacity()}});
+    owner.push_back(owner[0]);
+    CHECK(owner[owner.size() - 1] == owner[0]);
+
+    owner.resize({{0}});
+    owner.shrink_to_fit();
+    CHECK(owner.data() == nullptr);
+    CHECK(owner.capacity() == 0);
+}
+
+TEST_CASE("Owning array resize initialisation")
+{
+    Owning1DArray<int> owner;
+    owner.resize({{10}}, defaultInit);
+    std::fill(owner.data(), owner.data() + 10, -1);
+    owner.resize({{2}});
+    owner.resize({{5}});
+    CHECK(owner[0] == -1);
+    CHECK(owner[1] == -1);
+    for (size_t i = 2; i < 5; ++i)
+    {
+        CHECK(owner[i] == 0);
+    }
+}
@@ -0,0 +1,129 @@
+#include <core/parallel.h>
+
+#include <catch2/catch.hpp>
+
+#include <numeric>
+
+using namespace galaxias;
+
+TEST_CASE("Thread pool runs every task once")
+{
+    ThreadPool pool{3};
+    CHECK(pool.threads() == 3);
+
+    std::vector<std::atomic<int>> counts(1000);
+    pool.run(counts.size(), [&](size_t i) { ++counts[i]; });
+    CHECK(std::all_of(counts.begin(), counts.end(), [](const auto& c) { return c == 1; }));
+
+    // Nested batches
+    std::atomic<size_t> total{0};
+    pool.run(8, [&](size_t) { pool.run(100, [&](size_t j) { total += j; }); });
+    CHECK(total == 8 * 99 * 100 / 2);
+
+    // Exceptions reach the caller
+    CHECK_THROWS_AS(pool.run(10,
+                             [](size_t i)
+                             {
+                                 if (i == 7)
+                                 {
+                                     throw std::runtime_error("task");
+                                 }
+                             }),
+                    std::runtime_error);
+}
+
+TEST_CASE("Parallel for over arrays")
+{
+    OwningArray<int, 2> grid(std::array<size_t, 2>{{300, 500}});
+    std::iota(grid.data(), grid.data() + grid.size(), 0);
+    parallelFor(grid, [](int& x) { x *= 2; });
+    for (size_t i = 0; i < grid.size(); i += 997)
+    {
+        CHECK(grid[i] == 2 * static_cast<int>(i));
+    }
+
+    std::atomic<size_t> visited{0};
+    const auto& constGrid = grid;
+    parallelFor(constGrid, [&](int) { ++visited; });
+    CHECK(visited == grid.size());
+
+    std::vector<int> covered(1001, 0);
+    parallelFor(covered.size(),
+                64,
+                [&](size_t begin, size_t end)
+                {
+                    CHECK(end - begin <= 64);
+                    std::fill(covered.begin() + begin, covered.begin() + end, 1);
+                });
+    CHECK(std::accumulate(covered.begin(), covered.end(), 0) == 1001);
+}
+
+TEST_CASE("Deterministic parallel reduction")
+{
+    Owning1DArray<float> values(std::array<size_t, 1>{{1'000'003}});
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = 1.f / static_cast<float>(i + 1);
+    }
+    const auto add = [](float a, float b) { return a + b; };
+
+    // Same bits for any number of threads
+    ThreadPool one{1};
+    ThreadPool four{4};
+    const float sum1 = parallelReduce(values, 0.f, add, add, Reduction::Deterministic, one);
+    const float sum4 = parallelReduce(values, 0.f, add, add, Reduction::Deterministic, four);
+    CHECK(sum1 == sum4);
+    CHECK(sum1 == Approx(14.392727).epsilon(1e-4));
+    CHECK(parallelReduce(values, 0.f, add, add, Reduction::Unordered, four) == Approx(sum1));
+
+    // Accumulator type different from the elements
+    const size_t count = parallelReduce(
+        values, size_t{0}, [](size_t n, float x) { return n + (x < 0.001f); }, std::plus<size_t>());
+    CHECK(count == values.size() - 1000);
+}
+
+TEST_CASE("Tiled iteration")
+{
+    OwningArray<int, 3> grid(std::array<size_t, 3>{{7, 9, 10}});
+    std::fill(grid.data(), grid.data() + grid.size(), 0);
+    const std::array<size_t, 3> tile{{2, 4, 4}};
+
+    size_t tiles = 0;
+    forEachTile(grid.view(),
+                tile,
+                [&](const StridedView<int, 3>& t, const std::array<size_t, 3>& offset)
+                {
+                    CHECK(&t[{{0, 0, 0}}] == &grid[offset]);
+                    ++tiles;
+                });
+    CHECK(tiles == 4 * 3 * 3);
+
+    parallelTiles(grid.view(),
+                  tile,
+                  [](const StridedView<int, 3>& t, const std::array<size_t, 3>& offset)
+                  { t.forEach([&](int& x) { x += 1 + static_cast<int>(offset[0]); }); });
+    for (size_t i = 0; i < 7; ++i)
+    {
+        const auto slice = grid.view().slice(0, i);
+        const int expected = 1 + static_cast<int>(i / 2 * 2);
+        CHECK(std::all_of(slice.begin(), slice.end(), [&](int x) { return x == expected; }));
+    }
+
+    // Empty tile dims are single rows or columns, which still cover the whole view
+    size_t covered = 0;
+    tiles = 0;
+    forEachTile(grid.view(),
+                {{0, 4, 0}},
+                [&](const StridedView<int, 3>& t, const std::array<size_t, 3>&)
+                {
+                    covered += t.size();
+                    ++tiles;
+                });
+    CHECK(covered == grid.size());
+    CHECK(tiles == 7 * 3 * 10);
+    std::fill(grid.data(), grid.data() + grid.size(), 0);
+    parallelTiles(grid.view(),
+                  {{0, 0, 3}},
+                  [](const StridedView<int, 3>& t, const auto&) { t.forEach([](int& x) { ++x; }); });
+    CHECK(std::all_of(grid.data(), grid.data() + grid.size(), [](int x) { return x == 1; }));
+}
@@ -0,0 +1,111 @@
+#include <core/array.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace galaxias;
+
+namespace
+{
+
+template <class View>
+std::vector<int> elements(const View& view)
+{
+    std::vector<int> values;
+    for (int x : view)
+    {
+        values.push_back(x);
+    }
+    return values;
+}
+
+} // namespace
+
+TEST_CASE("Strided views on a 2D array")
+{
+    // 3 x 4 table: value = 10 * row + column
+    OwningArray<int, 2> table(std::array<size_t, 2>{{3, 4}});
+    for (size_t r = 0; r < 3; ++r)
+    {
+        for (size_t c = 0; c < 4; ++c)
+        {
+            table[{{r, c}}] = static_cast<int>(10 * r + c);
+        }
+    }
+
+    auto view = table.view();
+    CHECK(view.contiguous());
+    CHECK(view.size() == 12);
+    CHECK(view.span().data() == table.data());
+    CHECK(elements(view) == std::vector<int>{0, 1, 2, 3, 10, 11, 12, 13, 20, 21, 22, 23});
+
+    const auto row = view.row(1);
+    CHECK(row.contiguous());
+    CHECK(elements(row) == std::vector<int>{10, 11, 12, 13});
+
+    const auto column = view.column(2);
+    CHECK_FALSE(column.contiguous());
+    CHECK(column.size() == 3);
+    CHECK(column[1] == 12);
+    CHECK(elements(column) == std::vector<int>{2, 12, 22});
+    CHECK_THROWS_AS(column.span(), std::runtime_error);
+
+    const auto transposed = view.transpose();
+    CHECK(transposed.dims() == std::array<size_t, 2>{{4, 3}});
+    CHECK(transposed[{{3, 1}}] == 13);
+    CHECK(elements(transposed) == std::vector<int>{0, 10, 20, 1, 11, 21, 2, 12, 22, 3, 13, 23});
+
+    const auto block = view.subarray({{1, 1}}, {{2, 2}});
+    CHECK_FALSE(block.contiguous());
+    CHECK(elements(block) == std::vector<int>{11, 12, 21, 22});
+    CHECK_THROWS_AS(view.subarray({{2, 1}}, {{2, 2}}), std::out_of_range);
+    CHECK_THROWS_AS(view.slice(2, 0), std::out_of_range);
+
+    // Iterators outlive the temporary views they come from
+    const auto first = view.column(3).begin();
+    const auto last = view.column(3).end();
+    CHECK(std::vector<int>(first, last) == std::vector<int>{3, 13, 23});
+
+    // Views share memory
+    view.column(0).forEach([](int& x) { x = -x; });
+    CHECK(table[{{2, 0}}] == -20);
+    CHECK(table[{{2, 1}}] == 21);
+
+    // And convert to const
+    const auto& constTable = table;
+    StridedView<const int, 2> constView = view.transpose();
+    CHECK(constView[{{0, 2}}] == constTable.view()[{{2, 0}}]);
+}
+
+TEST_CASE("Strided views on a 3D grid")
+{
+    OwningArray<float, 3> grid(std::array<size_t, 3>{{4, 5, 6}});
+    std::iota(grid.data(), grid.data() + grid.size(), 0.f);
+    const auto view = grid.view();
+
+    // A full-width sub-block is contiguous
+    const auto slab = view.subarray({{1, 0, 0}}, {{2, 5, 6}});
+    CHECK(slab.contiguous());
+    CHECK(slab.span().front() == 30.f);
+
+    const auto block = view.subarray({{1, 2, 3}}, {{2, 2, 3}});
+    CHECK_FALSE(block.contiguous());
+    std::vector<float> values;
+    block.forEach([&](float x) { values.push_back(x); });
+    CHECK(values == std::vector<float>{45, 46, 47, 51, 52, 53, 75, 76, 77, 81, 82, 83});
+    CHECK(std::equal(values.begin(), values.end(), block.begin()));
+
+    // Slices along each dimension
+    CHECK(view.slice(0, 2)[{{1, 1}}] == 67.f);
+    CHECK(view.slice(1, 2)[{{1, 1}}] == 43.f);
+    CHECK(view.slice(2, 2)[{{1, 1}}] == 38.f);
+
+    const auto swapped = view.transpose(0, 2);
+    CHECK(swapped.dims() == std::array<size_t, 3>{{6, 5, 4}});
+    CHECK(swapped[{{3, 2, 1}}] == view[{{1, 2, 3}}]);
+    float sum = 0.f;
+    swapped.forEach([&](float x) { sum += x; });
+    CHECK(sum == Approx(119. * 120. / 2.));
+}
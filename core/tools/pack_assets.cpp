@@ -0,0 +1,66 @@
+#include <core/asset_pack.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <string>
+#include <vector>
+
+using namespace galaxias;
+
+namespace
+{
+
+void usage()
+{
+    std::fprintf(stderr,
+                 "Usage: pack_assets [--no-checksum] <output> <folder>\n"
+                 "Pack every file below folder, named by its path relative to folder\n");
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> args(argv + 1, argv + argc);
+    const auto option = std::find(args.begin(), args.end(), "--no-checksum");
+    const bool checksum = option == args.end();
+    if (!checksum)
+    {
+        args.erase(option);
+    }
+    if (args.size() != 2)
+    {
+        usage();
+        return 1;
+    }
+
+    try
+    {
+        const std::filesystem::path output{args[0]};
+        const std::filesystem::path folder{args[1]};
+        std::vector<std::filesystem::path> files;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator{folder})
+        {
+            if (entry.is_regular_file())
+            {
+                files.push_back(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+
+        AssetPackWriter writer;
+        for (const auto& file : files)
+        {
+            writer.add(file.lexically_relative(folder).generic_string(), file, checksum);
+        }
+        writer.write(output);
+        std::printf("Packed %zu assets into %s\n", files.size(), output.c_str());
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "pack_assets: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
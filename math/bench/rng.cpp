@@ -0,0 +1,184 @@
+#include <math/range.h>
+#include <math/rng/prng.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace galaxias;
+using namespace math;
+using namespace rng;
+
+namespace
+{
+
+constexpr size_t defaultSamples{size_t{1} << 24};
+constexpr size_t smokeSamples{size_t{1} << 20};
+constexpr Range<double> zeroOne = Range<double>::zeroOne();
+constexpr Range<int> intRange{0, 1000};
+
+const std::vector<float> quartiles{0.25, 0.25, 0.25, 0.25};
+
+/// Run the draw function on each thread with its own generator, report ns/sample and GB/s
+template <class Rng, class F>
+void measure(const char* generator, const char* distribution, size_t samples, size_t threads, size_t bytes, F&& draw)
+{
+    const size_t perThread = samples / threads;
+    std::vector<double> sinks(threads, 0.);
+    const auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; ++t)
+        {
+            workers.emplace_back(
+                [&, t]()
+                {
+                    Rng rng{42 + t};
+                    double sink = 0.;
+                    for (size_t i = 0; i < perThread; ++i)
+                    {
+                        sink += static_cast<double>(draw(rng));
+                    }
+                    sinks[t] = sink;
+                });
+        }
+        for (auto& w : workers)
+        {
+            w.join();
+        }
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    // Keep the sinks alive so draws are not optimised away
+    volatile double total = 0.;
+    for (double s : sinks)
+    {
+        total = total + s;
+    }
+
+    const double drawn = static_cast<double>(perThread * threads);
+    std::printf("%-10s %-16s %3zu thread(s) %9.3f ns/sample %8.3f GB/s\n",
+                generator,
+                distribution,
+                threads,
+                elapsed.count() / drawn,
+                drawn * static_cast<double>(bytes) / elapsed.count());
+}
+
+template <class Rng>
+void benchmark(const char* generator, size_t samples, size_t threads)
+{
+    measure<Rng>(generator, "uniform()", samples, threads, sizeof(uint64_t), [](Rng& rng) { return rng.uniform(); });
+    measure<Rng>(generator,
+                 "uniform(double)",
+                 samples,
+                 threads,
+                 sizeof(double),
+                 [](Rng& rng) { return rng.uniform(zeroOne); });
+    measure<Rng>(
+        generator, "uniform(int)", samples, threads, sizeof(int), [](Rng& rng) { return rng.uniform(intRange); });
+    measure<Rng>(generator,
+                 "gaussian",
+                 samples,
+                 threads,
+                 sizeof(double),
+                 [](Rng& rng) { return rng.template gaussian<double>(); });
+    measure<Rng>(generator,
+                 "realisation",
+                 samples,
+                 threads,
+                 sizeof(size_t),
+                 [](Rng& rng) { return rng.realisation(quartiles.begin(), quartiles.end()); });
+}
+
+/// Quick statistical checks: chi-square on the top byte, lag-1 serial correlation, gaussian moments
+template <class Rng>
+bool smokeTest(const char* generator)
+{
+    constexpr size_t bins{256};
+    constexpr double n = static_cast<double>(smokeSamples);
+    Rng rng{12345};
+
+    std::vector<size_t> counts(bins, 0);
+    for (size_t i = 0; i < smokeSamples; ++i)
+    {
+        ++counts[rng.uniform() >> 56];
+    }
+    double chi2 = 0.;
+    for (size_t c : counts)
+    {
+        const double diff = static_cast<double>(c) - n / bins;
+        chi2 += diff * diff / (n / bins);
+    }
+    // 255 degrees of freedom: reject both tails at ~0.1%
+    const bool chi2Ok = chi2 > 190. && chi2 < 335.;
+
+    // Knuth's serial correlation coefficient on consecutive values
+    double first = rng.uniform(zeroOne);
+    double previous = first;
+    double sum = first;
+    double sumSq = first * first;
+    double sumLag = 0.;
+    for (size_t i = 1; i < smokeSamples; ++i)
+    {
+        const double x = rng.uniform(zeroOne);
+        sum += x;
+        sumSq += x * x;
+        sumLag += previous * x;
+        previous = x;
+    }
+    sumLag += previous * first;
+    const double serial = (n * sumLag - sum * sum) / (n * sumSq - sum * sum);
+    const bool serialOk = std::abs(serial) < 5. / std::sqrt(n);
+
+    double mean = 0.;
+    double var = 0.;
+    for (size_t i = 0; i < smokeSamples; ++i)
+    {
+        const double x = rng.template gaussian<double>();
+        mean += x;
+        var += x * x;
+    }
+    mean /= n;
+    var = var / n - mean * mean;
+    const bool gaussianOk = std::abs(mean) < 5. / std::sqrt(n) && std::abs(var - 1.) < 0.01;
+
+    const bool ok = chi2Ok && serialOk && gaussianOk;
+    std::printf("%-10s chi2(255)=%.1f serial=%+.5f gaussian mean=%+.5f var=%.5f -> %s\n",
+                generator,
+                chi2,
+                serial,
+                mean,
+                var,
+                ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const size_t samples = argc > 1 ? std::stoull(argv[1]) : defaultSamples;
+    const size_t threads = std::max(1u, std::thread::hardware_concurrency());
+
+    bool ok = true;
+    ok &= smokeTest<Mersenne>("Mersenne");
+    ok &= smokeTest<Random>("Random");
+    ok &= smokeTest<Keyed>("Keyed");
+
+    for (size_t t : {size_t{1}, threads})
+    {
+        benchmark<Mersenne>("Mersenne", samples, t);
+        benchmark<Random>("Random", samples, t);
+        benchmark<Keyed>("Keyed", samples, t);
+        if (threads == 1)
+        {
+            break;
+        }
+    }
+
+    return ok ? 0 : 1;
+}
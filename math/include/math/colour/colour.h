@@ -1,7 +1,12 @@
 #pragma once
 
 #include "../quantity.h"
+#include <core/array.h>
+#include <core/thread_pool.h>
 
+#include <array>
+#include <cstdint>
+#include <span>
 #include <string>
 
 namespace galaxias
@@ -28,7 +33,17 @@ public:
     float b() const { return b_; }
     float a() const { return a_; }
 
+    /// Size of the buffer for the non-allocating hex, including the terminating zero
+    static constexpr size_t hexSize{11};
+
     std::string hex() const;
+    /// Write the same "0xrrggbbaa" as hex() into the buffer, without allocating
+    void hex(std::span<char, hexSize> buffer) const;
+
+    /// Pack as RGBA8 (channels are already sRGB-encoded): R in the lowest byte, i.e. R, G, B, A in memory
+    uint32_t rgba8() const;
+    /// Pack as four IEEE half floats R, G, B, A
+    std::array<uint16_t, 4> rgba16f() const;
 
 private:
     float r_;
@@ -37,7 +52,36 @@ private:
     float a_;
 };
 
+/// Batched Colour::fromXYZ over SoA arrays, vectorised and split in blocks over the pool.
+/// The gamma uses a fast exp/log approximation: colours match fromXYZ within 1e-5. All spans must have the same size
+void coloursFromXYZ(std::span<const float> x,
+                    std::span<const float> y,
+                    std::span<const float> z,
+                    std::span<Colour> colours,
+                    ThreadPool& pool = ThreadPool::global());
+/// Same as coloursFromXYZ, straight into a packed RGBA8 image (see Colour::rgba8), e.g. for sky maps
+void rgba8FromXYZ(std::span<const float> x,
+                  std::span<const float> y,
+                  std::span<const float> z,
+                  Owning1DArray<uint32_t>& image,
+                  ThreadPool& pool = ThreadPool::global());
+
+/// Fill a GPU buffer with one RGBA8 value per colour. The buffer is resized, so reusing it avoids allocating
+void packRGBA8(std::span<const Colour> colours, Owning1DArray<uint32_t>& buffer);
+/// Fill a GPU buffer with two values per colour, RG then BA as half floats (lowest bits first)
+void packRGBA16F(std::span<const Colour> colours, Owning1DArray<uint32_t>& buffer);
+
 Colour blackBodyColour(const quantity::Kelvin& temperature);
 
+/// Batched version of blackBodyColour, integrating many temperatures at once with a vectorised exponential.
+/// Matches blackBodyColour within 1e-5 per channel, temperatures below about 300 K falling back to it; both spans must
+/// have the same size
+void blackBodyColours(std::span<const quantity::Kelvin> temperatures, std::span<Colour> colours);
+
+/// Black body colour interpolated in a table log-spaced over [500, 100000] K, built once on first use.
+/// Maximum error against blackBodyColour is 1e-3 per channel, reached at the kinks of the gamut clipping (~890 K,
+/// ~1900 K, ~6535 K), and 2e-5 elsewhere over [1000, 100000] K. Temperatures out of the table are integrated exactly
+Colour blackBodyColourLookup(const quantity::Kelvin& temperature);
+
 } // namespace math
 } // namespace galaxias
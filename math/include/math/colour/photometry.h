@@ -0,0 +1,106 @@
+#pragma once
+
+#include "../quantity.h"
+#include <core/thread_pool.h>
+
+#include <span>
+#include <vector>
+
+namespace galaxias
+{
+namespace math
+{
+
+/// Transmission curve of a photometric filter, sampled on a regular wavelength grid
+class Bandpass
+{
+public:
+    Bandpass(const quantity::Metre& first, const quantity::Metre& step, std::vector<float> transmission);
+
+    /// Gaussian approximation of a filter, cut at 2 FWHM from the centre
+    static Bandpass gaussian(const quantity::Metre& centre, const quantity::Metre& fwhm);
+
+    quantity::Metre first() const { return first_; }
+    quantity::Metre last() const { return first_ + step_ * static_cast<double>(transmission_.size() - 1); }
+
+    /// Linearly interpolated transmission, zero out of the sampled range
+    float transmission(const quantity::Metre& wavelength) const;
+
+private:
+    quantity::Metre first_;
+    quantity::Metre step_;
+    std::vector<float> transmission_;
+};
+
+/// Bands of the Johnson-Cousins UBVRI system, in the order of Photometry::johnsonCousins()
+enum class JohnsonBand
+{
+    U,
+    B,
+    V,
+    R,
+    I,
+};
+
+/// Synthetic photometry of black bodies: bolometric corrections BC = M_band - M_bol for a set of bands.
+/// Zero points put a 9600 K black body (Vega-like) at BC = -0.25 in every band, hence at colour 0.
+/// Values come from a (log temperature, band) table over [1000, 100000] K, within 2e-4 mag of the exact integration;
+/// other temperatures are integrated exactly
+class Photometry
+{
+public:
+    Photometry(std::vector<Bandpass> bands);
+
+    /// Johnson U, B, V and Cousins R, I approximated by gaussian filters
+    static const Photometry& johnsonCousins();
+
+    size_t bands() const { return bands_.size(); }
+
+    double bolometricCorrection(const quantity::Kelvin& temperature, size_t band) const;
+    double bolometricCorrection(const quantity::Kelvin& temperature, JohnsonBand band) const
+    {
+        return bolometricCorrection(temperature, static_cast<size_t>(band));
+    }
+    /// Exact integration, bypassing the table
+    double exactBolometricCorrection(const quantity::Kelvin& temperature, size_t band) const;
+
+    /// Colour index M_first - M_second, e.g. B - V
+    double colourIndex(const quantity::Kelvin& temperature, size_t first, size_t second) const;
+    double colourIndex(const quantity::Kelvin& temperature, JohnsonBand first, JohnsonBand second) const
+    {
+        return colourIndex(temperature, static_cast<size_t>(first), static_cast<size_t>(second));
+    }
+
+    /// Bulk versions for whole catalogues, split in blocks over the pool
+    void bolometricCorrections(std::span<const quantity::Kelvin> temperatures,
+                               size_t band,
+                               std::span<float> corrections,
+                               ThreadPool& pool = ThreadPool::global()) const;
+    void colourIndices(std::span<const quantity::Kelvin> temperatures,
+                       size_t first,
+                       size_t second,
+                       std::span<float> indices,
+                       ThreadPool& pool = ThreadPool::global()) const;
+
+private:
+    void checkBand(size_t band) const;
+    double integrate(double temperature, size_t band) const;
+
+private:
+    std::vector<Bandpass> bands_;
+
+    // Common wavelength grid and per-band weights (transmission * sample width)
+    std::vector<float> scale_;
+    std::vector<float> exponent_;
+    std::vector<double> wavelengths_;
+    std::vector<std::vector<float>> weights_;
+
+    // Zero points and table of corrections, row-major (temperature, band)
+    std::vector<double> zeroPoints_;
+    double logLow_;
+    double logStep_;
+    std::vector<float> table_;
+};
+
+} // namespace math
+} // namespace galaxias
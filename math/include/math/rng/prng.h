@@ -49,6 +49,31 @@ private:
     std::array<uint64_t, 4> s_;
 };
 
+/// Counter-based generator: the i-th output of a stream is a keyed hash of (key, stream, i), which gives O(1) random
+/// access to any draw and makes independent streams free to create (e.g. one per property of a system)
+class SplitMixCounter
+{
+public:
+    using result_type = uint64_t;
+
+    SplitMixCounter(uint64_t key, uint64_t stream = 0, uint64_t index = 0);
+
+    uint64_t operator()() { return at(index_++); }
+    /// Return the output at a given position of the stream, without changing the state
+    uint64_t at(uint64_t index) const;
+
+    uint64_t index() const { return index_; }
+    void seek(uint64_t index) { index_ = index; }
+    void discard(uint64_t count) { index_ += count; }
+
+    static constexpr uint64_t min() { return 0; }
+    static constexpr uint64_t max() { return std::numeric_limits<uint64_t>::max(); }
+
+private:
+    uint64_t key_;
+    uint64_t index_;
+};
+
 } // namespace detail
 
 template <class T>
@@ -68,6 +93,11 @@ public:
         : PRNG{reference.uniform() ^ seedMask}
     {
     }
+    /// Construct an RNG around an existing generator state
+    explicit PRNG(const T& generator)
+        : generator_{generator}
+    {
+    }
     virtual ~PRNG() = default;
 
     /// Return a value in range [0, max)
@@ -109,6 +139,7 @@ private:
 
 using Mersenne = PRNG<std::mt19937_64>;
 using Random = PRNG<detail::Xoshiro256>;
+using Keyed = PRNG<detail::SplitMixCounter>;
 
 } // namespace rng
 } // namespace math
@@ -1,6 +1,10 @@
 #pragma once
 
 #include "../range.h"
+#include "prng.h"
+#include <core/thread_pool.h>
+
+#include <algorithm>
 
 namespace galaxias
 {
@@ -25,6 +29,152 @@ void shuffle(const It& begin, const It& end, Rng& rng)
     }
 }
 
+namespace detail
+{
+
+__extension__ using uint128 = unsigned __int128;
+
+/// Return an unbiased value in [0, n) from 64-bit draws (Lemire's nearly divisionless method)
+template <class Rng>
+uint64_t bounded(uint64_t n, Rng& rng)
+{
+    uint128 m = static_cast<uint128>(rng.uniform()) * n;
+    if (static_cast<uint64_t>(m) < n)
+    {
+        const uint64_t threshold = -n % n;
+        while (static_cast<uint64_t>(m) < threshold)
+        {
+            m = static_cast<uint128>(rng.uniform()) * n;
+        }
+    }
+    return static_cast<uint64_t>(m >> 64);
+}
+
+/// Return unbiased values in [0, n) and [0, n - 1) from a single 64-bit draw, valid while n * (n - 1) < 2^64
+/// See Brackett-Rozinsky & Lemire, "Batched Ranged Random Integer Generation"
+template <class Rng>
+std::pair<uint64_t, uint64_t> boundedPair(uint64_t n, Rng& rng)
+{
+    uint128 m = static_cast<uint128>(rng.uniform()) * n;
+    uint128 m2 = static_cast<uint128>(static_cast<uint64_t>(m)) * (n - 1);
+    const uint64_t bound = n * (n - 1);
+    if (static_cast<uint64_t>(m2) < bound)
+    {
+        const uint64_t threshold = -bound % bound;
+        while (static_cast<uint64_t>(m2) < threshold)
+        {
+            m = static_cast<uint128>(rng.uniform()) * n;
+            m2 = static_cast<uint128>(static_cast<uint64_t>(m)) * (n - 1);
+        }
+    }
+    return {static_cast<uint64_t>(m >> 64), static_cast<uint64_t>(m2 >> 64)};
+}
+
+/// Merge two shuffled consecutive ranges into one shuffled range (MergeShuffle, Bacher et al. 2015)
+template <class It, class Rng>
+void mergeShuffled(const It& begin, const It& middle, const It& end, Rng& rng)
+{
+    auto i = begin;
+    auto j = middle;
+    uint64_t bits = 0;
+    size_t available = 0;
+    while (true)
+    {
+        if (available == 0)
+        {
+            bits = rng.uniform();
+            available = 64;
+        }
+        const bool fromRight = bits & 1;
+        bits >>= 1;
+        --available;
+        if (fromRight)
+        {
+            if (j == end)
+            {
+                break;
+            }
+            std::iter_swap(i, j);
+            ++j;
+        }
+        else if (i == j)
+        {
+            break;
+        }
+        ++i;
+    }
+
+    // Insert the remaining elements at random positions
+    for (; i != end; ++i)
+    {
+        std::iter_swap(i, begin + bounded(std::distance(begin, i) + 1, rng));
+    }
+}
+
+} // namespace detail
+
+/// Fisher-Yates shuffle drawing two indices per 64-bit value, for RNGs providing a 64-bit uniform()
+template <class It, class Rng>
+void batchedShuffle(const It& begin, const It& end, Rng& rng)
+{
+    uint64_t size = std::distance(begin, end);
+    for (; size > (uint64_t{1} << 32); --size)
+    {
+        std::iter_swap(begin + (size - 1), begin + detail::bounded(size, rng));
+    }
+    for (; size > 2; size -= 2)
+    {
+        const auto [i, j] = detail::boundedPair(size, rng);
+        std::iter_swap(begin + (size - 1), begin + i);
+        std::iter_swap(begin + (size - 2), begin + j);
+    }
+    if (size == 2)
+    {
+        std::iter_swap(begin + 1, begin + detail::bounded(2, rng));
+    }
+}
+
+/// Shuffle in parallel: blocks are shuffled independently then merged pairwise, each task using its own substream.
+/// The result only depends on the seed and block size, not on the pool
+template <class It>
+void parallelShuffle(const It& begin,
+                     const It& end,
+                     uint64_t seed,
+                     ThreadPool& pool = ThreadPool::global(),
+                     size_t blockSize = size_t{1} << 16)
+{
+    const size_t size = std::distance(begin, end);
+    const size_t blocks = std::max<size_t>(1, (size + blockSize - 1) / blockSize);
+    const auto substream = [seed](uint64_t level, uint64_t task)
+    { return Keyed{detail::SplitMixCounter{seed, (level << 48) | task}}; };
+
+    pool.run(blocks,
+             [&](size_t b)
+             {
+                 auto rng = substream(0, b);
+                 const auto first = begin + b * blockSize;
+                 batchedShuffle(first, first + std::min(blockSize, size - b * blockSize), rng);
+             });
+
+    size_t level = 1;
+    for (size_t width = blockSize; width < size; width *= 2, ++level)
+    {
+        const size_t merges = (size + 2 * width - 1) / (2 * width);
+        pool.run(merges,
+                 [&](size_t m)
+                 {
+                     const size_t first = m * 2 * width;
+                     const size_t middle = first + width;
+                     if (middle < size)
+                     {
+                         auto rng = substream(level, m);
+                         detail::mergeShuffled(
+                             begin + first, begin + middle, begin + std::min(middle + width, size), rng);
+                     }
+                 });
+    }
+}
+
 } // namespace rng
 } // namespace math
 } // namespace galaxias
@@ -11,6 +11,7 @@ set(library_src
     include/${library_name}/unit.h
 
     include/${library_name}/colour/colour.h
+    include/${library_name}/colour/photometry.h
 
     include/${library_name}/rng/fixed_proba.h
     include/${library_name}/rng/prng.h
@@ -26,8 +27,13 @@ set(library_src
 
     src/colour/blackbody.cpp
     src/colour/colour.cpp
+    src/colour/conversion.h
+    src/colour/fast_math.h
+    src/colour/photometry.cpp
+    src/colour/spectrum.h
 
     src/rng/mersenne.cpp
+    src/rng/splitmix_counter.cpp
     src/rng/xoshiro256.cpp
 
     src/solver/bisection.cpp
@@ -1,12 +1,19 @@
 #include <math/colour/colour.h>
 
+#include "conversion.h"
+#include "spectrum.h"
+
 //                Colour Rendering of Spectra
 //
 //                       by John Walker
 //                  http://www.fourmilab.ch/
 //          http://www.fourmilab.ch/documents/specrend/
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
 
 namespace galaxias
 {
@@ -46,8 +53,86 @@ static constexpr std::array<std::array<float, 3>, 81> coloursCIE = {{
     {{0.0001f, 0.0000f, 0.0000f}}, {{0.0001f, 0.0000f, 0.0000f}}, {{0.0000f, 0.0000f, 0.0000f}},
 }};
 
+constexpr size_t cieSamples{coloursCIE.size()};
+constexpr double cieFirstWavelength{380e-9};
+constexpr double cieDeltaWavelength{5e-9};
+
+/// One CIE channel as a contiguous array, for the batched integration
+template <size_t C>
+constexpr std::array<float, cieSamples> cieChannel()
+{
+    std::array<float, cieSamples> channel{};
+    for (size_t i = 0; i < cieSamples; ++i)
+    {
+        channel[i] = coloursCIE[i][C];
+    }
+    return channel;
+}
+
+/// Per-sample Planck factors c1 * lambda^-5 and c2 / lambda
+template <bool Exponent>
+constexpr std::array<float, cieSamples> planckFactors()
+{
+    std::array<float, cieSamples> factors{};
+    for (size_t i = 0; i < cieSamples; ++i)
+    {
+        const double wavelength = cieFirstWavelength + static_cast<double>(i) * cieDeltaWavelength;
+        factors[i] = static_cast<float>(Exponent ? detail::planckC2 / wavelength
+                                                 : detail::planckC1 / (wavelength * wavelength * wavelength *
+                                                                       wavelength * wavelength));
+    }
+    return factors;
 }
 
+alignas(64) constexpr std::array<float, cieSamples> cieX = cieChannel<0>();
+alignas(64) constexpr std::array<float, cieSamples> cieY = cieChannel<1>();
+alignas(64) constexpr std::array<float, cieSamples> cieZ = cieChannel<2>();
+alignas(64) constexpr std::array<float, cieSamples> cieScale = planckFactors<false>();
+alignas(64) constexpr std::array<float, cieSamples> cieExponent = planckFactors<true>();
+
+/// Below about 300 K even the longest wavelengths have exponentials that fastExp cannot represent to within 1e-5 of
+/// the total, so such temperatures are integrated by blackBodyColour
+constexpr float batchExponentLimit{60.f};
+
+constexpr double lookupLow{500.};
+constexpr double lookupHigh{100000.};
+constexpr size_t lookupSize{2048};
+
+class BlackBodyTable
+{
+public:
+    BlackBodyTable()
+        : logLow_{std::log(lookupLow)}
+        , step_{(std::log(lookupHigh) - logLow_) / (lookupSize - 1)}
+    {
+        rgb_.reserve(lookupSize);
+        for (size_t i = 0; i < lookupSize; ++i)
+        {
+            const Colour col = blackBodyColour(std::exp(logLow_ + static_cast<double>(i) * step_));
+            rgb_.push_back({{col.r(), col.g(), col.b()}});
+        }
+    }
+
+    Colour operator()(double temperature) const
+    {
+        const double x = (std::log(temperature) - logLow_) / step_;
+        const size_t i = std::min(static_cast<size_t>(x), lookupSize - 2);
+        const float t = static_cast<float>(x - static_cast<double>(i));
+        const auto& lo = rgb_[i];
+        const auto& hi = rgb_[i + 1];
+        return Colour{std::clamp(lo[0] + t * (hi[0] - lo[0]), 0.f, 1.f),
+                      std::clamp(lo[1] + t * (hi[1] - lo[1]), 0.f, 1.f),
+                      std::clamp(lo[2] + t * (hi[2] - lo[2]), 0.f, 1.f)};
+    }
+
+private:
+    const double logLow_;
+    const double step_;
+    std::vector<std::array<float, 3>> rgb_;
+};
+
+} // namespace
+
 Colour blackBodyColour(const quantity::Kelvin& temperature)
 {
     // Convert temperature to XYZ
@@ -77,5 +162,57 @@ Colour blackBodyColour(const quantity::Kelvin& temperature)
     return Colour::fromXYZ(x, y, z);
 }
 
+void blackBodyColours(std::span<const quantity::Kelvin> temperatures, std::span<Colour> colours)
+{
+    if (temperatures.size() != colours.size())
+    {
+        throw std::runtime_error("Mismatching sizes: " + std::to_string(temperatures.size()) + " temperatures for " +
+                                 std::to_string(colours.size()) + " colours");
+    }
+
+    constexpr size_t lanes{detail::spectrumLanes};
+    std::array<float, lanes> inverseT;
+    std::array<std::array<float, lanes>, 3> xyz;
+    std::array<std::array<float, lanes>, 3> rgb;
+    for (size_t first = 0; first < temperatures.size(); first += lanes)
+    {
+        // Pad the last batch by repeating its last temperature
+        const size_t count = std::min(lanes, temperatures.size() - first);
+        for (size_t t = 0; t < lanes; ++t)
+        {
+            inverseT[t] = static_cast<float>(1. / temperatures[first + std::min(t, count - 1)].value());
+        }
+
+        detail::integratePlanck<3>(
+            cieScale.data(), cieExponent.data(), {{cieX.data(), cieY.data(), cieZ.data()}}, cieSamples, inverseT, xyz);
+
+        for (size_t t = 0; t < lanes; ++t)
+        {
+            const float total = xyz[0][t] + xyz[1][t] + xyz[2][t];
+            xyz[0][t] /= total;
+            xyz[1][t] /= total;
+            xyz[2][t] /= total;
+        }
+        detail::xyzToRGB(
+            xyz[0].data(), xyz[1].data(), xyz[2].data(), rgb[0].data(), rgb[1].data(), rgb[2].data(), lanes);
+        for (size_t t = 0; t < count; ++t)
+        {
+            colours[first + t] = cieExponent.back() * inverseT[t] > batchExponentLimit
+                                     ? blackBodyColour(temperatures[first + t])
+                                     : Colour{rgb[0][t], rgb[1][t], rgb[2][t]};
+        }
+    }
+}
+
+Colour blackBodyColourLookup(const quantity::Kelvin& temperature)
+{
+    if (temperature < lookupLow || temperature > lookupHigh)
+    {
+        return blackBodyColour(temperature);
+    }
+    static const BlackBodyTable table;
+    return table(temperature.value());
+}
+
 } // namespace math
 } // namespace galaxias
@@ -1,7 +1,10 @@
 #include <math/colour/colour.h>
 
-#include <iomanip>
-#include <sstream>
+#include "conversion.h"
+#include <core/parallel.h>
+
+#include <bit>
+#include <cmath>
 #include <stdexcept>
 
 namespace galaxias
@@ -19,6 +22,70 @@ constexpr float g2 = 1.f / 2.4f;
 constexpr float g3 = 0.055;
 float gamma(float c) { return c <= lim ? (g0 * c) : (g1 * std::pow(c, g2) - g3); }
 
+uint32_t toByte(float c) { return static_cast<uint32_t>(c * 255.f + 0.5f); }
+
+/// IEEE 754 binary16 conversion with round to nearest even
+uint16_t toHalf(float value)
+{
+    const uint32_t bits = std::bit_cast<uint32_t>(value);
+    const uint32_t sign = (bits >> 16) & 0x8000;
+    const uint32_t magnitude = bits & 0x7FFFFFFF;
+    if (magnitude >= 0x47800000)
+    {
+        // Too large, infinite or nan
+        return sign | (magnitude > 0x7F800000 ? 0x7E00 : 0x7C00);
+    }
+    if (magnitude < 0x38800000)
+    {
+        // Subnormal in half precision: multiple of 2^-24
+        return sign | static_cast<uint16_t>(std::nearbyint(std::abs(value) * 16777216.f));
+    }
+    uint32_t half = (magnitude - 0x38000000) >> 13;
+    const uint32_t rest = magnitude & 0x1FFF;
+    if (rest > 0x1000 || (rest == 0x1000 && (half & 1)))
+    {
+        ++half;
+    }
+    return sign | half;
+}
+
+/// Pixels converted together by a task, small enough for the SoA scratch to stay in L1
+constexpr size_t conversionBlock{1024};
+
+void checkSizes(std::span<const float> x, std::span<const float> y, std::span<const float> z, size_t size)
+{
+    if (x.size() != size || y.size() != size || z.size() != size)
+    {
+        throw std::runtime_error("Mismatching sizes: " + std::to_string(x.size()) + ", " + std::to_string(y.size()) +
+                                 ", " + std::to_string(z.size()) + " XYZ for " + std::to_string(size) + " colours");
+    }
+}
+
+/// Convert XYZ to RGB block by block, handing each block's SoA result to output(first, count, r, g, b)
+template <class F>
+void convertBlocks(std::span<const float> x,
+                   std::span<const float> y,
+                   std::span<const float> z,
+                   size_t size,
+                   ThreadPool& pool,
+                   const F& output)
+{
+    checkSizes(x, y, z, size);
+    parallelFor(
+        size,
+        conversionBlock,
+        [&](size_t first, size_t end)
+        {
+            alignas(64) std::array<float, conversionBlock> r;
+            alignas(64) std::array<float, conversionBlock> g;
+            alignas(64) std::array<float, conversionBlock> b;
+            const size_t count = end - first;
+            detail::xyzToRGB(x.data() + first, y.data() + first, z.data() + first, r.data(), g.data(), b.data(), count);
+            output(first, count, r, g, b);
+        },
+        pool);
+}
+
 } // namespace
 
 Colour::Colour(float r, float g, float b, float a)
@@ -36,15 +103,30 @@ Colour::Colour(float r, float g, float b, float a)
 
 std::string Colour::hex() const
 {
-    std::stringstream out;
-    out << "0x" << std::setfill('0') << std::hex        //
-        << std::setw(2) << static_cast<int>(r_ * 255.)  //
-        << std::setw(2) << static_cast<int>(g_ * 255.)  //
-        << std::setw(2) << static_cast<int>(b_ * 255.)  //
-        << std::setw(2) << static_cast<int>(a_ * 255.); //
-    return out.str();
+    std::array<char, hexSize> buffer;
+    hex(buffer);
+    return std::string(buffer.data(), hexSize - 1);
 }
 
+void Colour::hex(std::span<char, hexSize> buffer) const
+{
+    static constexpr auto digits = "0123456789abcdef";
+    buffer[0] = '0';
+    buffer[1] = 'x';
+    size_t i = 2;
+    for (float c : {r_, g_, b_, a_})
+    {
+        const int value = static_cast<int>(c * 255.);
+        buffer[i++] = digits[value >> 4];
+        buffer[i++] = digits[value & 0xF];
+    }
+    buffer[i] = '\0';
+}
+
+uint32_t Colour::rgba8() const { return toByte(r_) | (toByte(g_) << 8) | (toByte(b_) << 16) | (toByte(a_) << 24); }
+
+std::array<uint16_t, 4> Colour::rgba16f() const { return {{toHalf(r_), toHalf(g_), toHalf(b_), toHalf(a_)}}; }
+
 Colour Colour::fromXYZ(float x, float y, float z)
 {
     float r = gamma(3.2404542 * x - 1.5371385 * y - 0.4985314 * z);
@@ -72,5 +154,69 @@ Colour Colour::fromXYZ(float x, float y, float z)
     return Colour(r, g, b);
 }
 
+void coloursFromXYZ(std::span<const float> x,
+                    std::span<const float> y,
+                    std::span<const float> z,
+                    std::span<Colour> colours,
+                    ThreadPool& pool)
+{
+    convertBlocks(x,
+                  y,
+                  z,
+                  colours.size(),
+                  pool,
+                  [&](size_t first, size_t count, const auto& r, const auto& g, const auto& b)
+                  {
+                      for (size_t i = 0; i < count; ++i)
+                      {
+                          colours[first + i] = Colour{r[i], g[i], b[i]};
+                      }
+                  });
+}
+
+void rgba8FromXYZ(std::span<const float> x,
+                  std::span<const float> y,
+                  std::span<const float> z,
+                  Owning1DArray<uint32_t>& image,
+                  ThreadPool& pool)
+{
+    // Before resizing, so that a bad call leaves the image untouched
+    checkSizes(x, y, z, x.size());
+    image.resize({{x.size()}}, defaultInit);
+    uint32_t* pixels = image.alignedData();
+    convertBlocks(x,
+                  y,
+                  z,
+                  image.size(),
+                  pool,
+                  [&](size_t first, size_t count, const auto& r, const auto& g, const auto& b)
+                  {
+                      for (size_t i = 0; i < count; ++i)
+                      {
+                          pixels[first + i] = toByte(r[i]) | (toByte(g[i]) << 8) | (toByte(b[i]) << 16) | 0xFF000000;
+                      }
+                  });
+}
+
+void packRGBA8(std::span<const Colour> colours, Owning1DArray<uint32_t>& buffer)
+{
+    buffer.resize({{colours.size()}}, defaultInit);
+    for (size_t i = 0; i < colours.size(); ++i)
+    {
+        buffer[i] = colours[i].rgba8();
+    }
+}
+
+void packRGBA16F(std::span<const Colour> colours, Owning1DArray<uint32_t>& buffer)
+{
+    buffer.resize({{2 * colours.size()}}, defaultInit);
+    for (size_t i = 0; i < colours.size(); ++i)
+    {
+        const auto half = colours[i].rgba16f();
+        buffer[2 * i] = static_cast<uint32_t>(half[0]) | (static_cast<uint32_t>(half[1]) << 16);
+        buffer[2 * i + 1] = static_cast<uint32_t>(half[2]) | (static_cast<uint32_t>(half[3]) << 16);
+    }
+}
+
 } // namespace math
 } // namespace galaxias
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "fast_math.h"
+
+namespace galaxias
+{
+namespace math
+{
+namespace detail
+{
+
+/// Batched Colour::fromXYZ on SoA arrays: linear sRGB matrix, gamma, positivity and normalisation to the largest channel
+inline void xyzToRGB(const float* __restrict x,
+                     const float* __restrict y,
+                     const float* __restrict z,
+                     float* __restrict r,
+                     float* __restrict g,
+                     float* __restrict b,
+                     size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        float ri = srgbGamma(3.2404542f * x[i] - 1.5371385f * y[i] - 0.4985314f * z[i]);
+        float gi = srgbGamma(-0.9692660f * x[i] + 1.8760108f * y[i] + 0.0415560f * z[i]);
+        float bi = srgbGamma(0.0556434f * x[i] - 0.2040259f * y[i] + 1.0572252f * z[i]);
+
+        // Enforce positivity
+        const float w = maxf(0.f, -minf(ri, minf(gi, bi)));
+        ri += w;
+        gi += w;
+        bi += w;
+
+        // Normalise to the largest (divide rather than multiply by the inverse to get exactly 1 for the largest)
+        const float n = maxf(ri, maxf(gi, bi));
+        const float divisor = select(std::bit_cast<int32_t>(n) > 0, n, 1.f);
+        r[i] = ri / divisor;
+        g[i] = gi / divisor;
+        b[i] = bi / divisor;
+    }
+}
+
+} // namespace detail
+} // namespace math
+} // namespace galaxias
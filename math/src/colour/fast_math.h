@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+namespace galaxias
+{
+namespace math
+{
+namespace detail
+{
+
+// Float compares prevent GCC from vectorising loops unless -fno-trapping-math is given, so the helpers below compare
+// bit patterns as integers instead and stay branch-free
+
+/// Map a float onto an integer with the same ordering (and back, the mapping is its own inverse)
+inline int32_t orderedBits(int32_t bits) { return bits ^ ((bits >> 31) & 0x7FFFFFFF); }
+
+inline float minf(float a, float b)
+{
+    return std::bit_cast<float>(orderedBits(
+        std::min(orderedBits(std::bit_cast<int32_t>(a)), orderedBits(std::bit_cast<int32_t>(b)))));
+}
+
+inline float maxf(float a, float b)
+{
+    return std::bit_cast<float>(orderedBits(
+        std::max(orderedBits(std::bit_cast<int32_t>(a)), orderedBits(std::bit_cast<int32_t>(b)))));
+}
+
+/// Select a if the condition holds, b otherwise. Bitwise so that both sides are computed and the compiler does not
+/// move a possibly trapping computation under a branch
+inline float select(bool condition, float a, float b)
+{
+    const int32_t mask = -static_cast<int32_t>(condition);
+    return std::bit_cast<float>((std::bit_cast<int32_t>(a) & mask) | (std::bit_cast<int32_t>(b) & ~mask));
+}
+
+/// Clamp x to at most high (positive), valid for any x
+inline float clampBelow(float x, float high)
+{
+    return std::bit_cast<float>(std::min(std::bit_cast<int32_t>(x), std::bit_cast<int32_t>(high)));
+}
+
+/// Input range of fastExp, exp(88) being close to the largest float
+constexpr float fastExpLow{-87.f};
+constexpr float fastExpHigh{88.f};
+
+/// Fast exponential: exp(x) = 2^n * exp(r) with n = round(x / ln 2), r = x - n * ln 2 (split in two parts for
+/// accuracy) and exp(r) from a degree 6 polynomial. Relative error is below 5e-7 for x in [-87, 88]; out of this range
+/// the input is clamped
+inline float fastExp(float x)
+{
+    x = -clampBelow(-clampBelow(x, fastExpHigh), -fastExpLow);
+    // Round to nearest by adding and removing 1.5 * 2^23
+    const float n = (x * 1.44269504f + 12582912.f) - 12582912.f;
+    const float r = (x - n * 0.693145752f) - n * 1.42860677e-6f;
+    float p = 1.f / 720.f;
+    p = p * r + 1.f / 120.f;
+    p = p * r + 1.f / 24.f;
+    p = p * r + 1.f / 6.f;
+    p = p * r + 0.5f;
+    p = p * r + 1.f;
+    p = p * r + 1.f;
+    return p * std::bit_cast<float>((static_cast<int32_t>(n) + 127) << 23);
+}
+
+/// Fast natural logarithm for positive normal x: ln(x) = e * ln 2 + ln(m) with m in [sqrt(1/2), sqrt(2)) and
+/// ln(m) = 2 atanh(s), s = (m - 1) / (m + 1), from its series up to s^9. Absolute error is below 2e-7
+inline float fastLog(float x)
+{
+    const int32_t bits = std::bit_cast<int32_t>(x);
+    // Move mantissas above sqrt(2) into the lower octave
+    const int32_t high = (bits & 0x7FFFFF) > 0x3504F3 ? 1 : 0;
+    const float m = std::bit_cast<float>((bits & 0x7FFFFF) | ((127 - high) << 23));
+    const float e = static_cast<float>((bits >> 23) - 127 + high);
+    const float s = (m - 1.f) / (m + 1.f);
+    const float s2 = s * s;
+    float p = 1.f / 9.f;
+    p = p * s2 + 1.f / 7.f;
+    p = p * s2 + 1.f / 5.f;
+    p = p * s2 + 1.f / 3.f;
+    p = p * s2 + 1.f;
+    return e * 0.693147181f + 2.f * s * p;
+}
+
+/// sRGB transfer function (linear to gamma-encoded), with a relative error below 1e-6 against std::pow
+inline float srgbGamma(float c)
+{
+    const float linear = 12.92f * c;
+    const float curve = 1.055f * fastExp(fastLog(c) * (1.f / 2.4f)) - 0.055f;
+    // Also takes negative values (as integers, lower than the threshold) on the linear part
+    return select(std::bit_cast<int32_t>(c) <= std::bit_cast<int32_t>(0.0031308f), linear, curve);
+}
+
+} // namespace detail
+} // namespace math
+} // namespace galaxias
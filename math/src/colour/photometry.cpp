@@ -0,0 +1,245 @@
+#include <math/colour/photometry.h>
+
+#include "spectrum.h"
+#include <core/parallel.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace galaxias
+{
+namespace math
+{
+
+namespace
+{
+
+constexpr double gridStep{5e-9};
+constexpr double tableLow{1000.};
+constexpr double tableHigh{100000.};
+constexpr size_t tableSize{1024};
+constexpr double vegaTemperature{9600.};
+constexpr double vegaCorrection{-0.25};
+constexpr double stefanBoltzmann{5.670374419e-8};
+constexpr size_t bulkBlock{4096};
+
+/// Bolometric correction before zero point, from the flux through the band
+double rawCorrection(double flux, double temperature)
+{
+    return -2.5 * std::log10(flux / (stefanBoltzmann * std::pow(temperature, 4.)));
+}
+
+} // namespace
+
+Bandpass::Bandpass(const quantity::Metre& first, const quantity::Metre& step, std::vector<float> transmission)
+    : first_{first}
+    , step_{step}
+    , transmission_{std::move(transmission)}
+{
+    if (transmission_.size() < 2 || step_ <= 0.)
+    {
+        throw std::runtime_error("Bandpass needs at least 2 samples and a positive step");
+    }
+}
+
+Bandpass Bandpass::gaussian(const quantity::Metre& centre, const quantity::Metre& fwhm)
+{
+    constexpr size_t samples{81};
+    const double sigma = fwhm.value() / (2. * std::sqrt(2. * std::log(2.)));
+    const quantity::Metre first = centre - fwhm * 2.;
+    const quantity::Metre step = fwhm * (4. / static_cast<double>(samples - 1));
+    std::vector<float> transmission(samples);
+    for (size_t i = 0; i < samples; ++i)
+    {
+        const double x = (first + step * static_cast<double>(i) - centre).value() / sigma;
+        transmission[i] = static_cast<float>(std::exp(-0.5 * x * x));
+    }
+    return Bandpass{first, step, std::move(transmission)};
+}
+
+float Bandpass::transmission(const quantity::Metre& wavelength) const
+{
+    const double x = (wavelength - first_).value() / step_.value();
+    if (x < 0. || x > static_cast<double>(transmission_.size() - 1))
+    {
+        return 0.f;
+    }
+    const size_t i = std::min(static_cast<size_t>(x), transmission_.size() - 2);
+    const float t = static_cast<float>(x - static_cast<double>(i));
+    return transmission_[i] + t * (transmission_[i + 1] - transmission_[i]);
+}
+
+////////////////////////////////////////////////////////////////
+
+Photometry::Photometry(std::vector<Bandpass> bands)
+    : bands_{std::move(bands)}
+    , logLow_{std::log(tableLow)}
+    , logStep_{(std::log(tableHigh) - logLow_) / (tableSize - 1)}
+{
+    if (bands_.empty())
+    {
+        throw std::runtime_error("Photometry needs at least one band");
+    }
+
+    // Common wavelength grid covering all bands
+    double low = bands_.front().first().value();
+    double high = bands_.front().last().value();
+    for (const auto& band : bands_)
+    {
+        low = std::min(low, band.first().value());
+        high = std::max(high, band.last().value());
+    }
+    const size_t samples = static_cast<size_t>(std::ceil((high - low) / gridStep)) + 1;
+    weights_.resize(bands_.size());
+    for (size_t i = 0; i < samples; ++i)
+    {
+        const double wavelength = low + static_cast<double>(i) * gridStep;
+        wavelengths_.push_back(wavelength);
+        scale_.push_back(static_cast<float>(detail::planckC1 / std::pow(wavelength, 5.)));
+        exponent_.push_back(static_cast<float>(detail::planckC2 / wavelength));
+        for (size_t b = 0; b < bands_.size(); ++b)
+        {
+            weights_[b].push_back(bands_[b].transmission(wavelength) * static_cast<float>(gridStep));
+        }
+    }
+
+    zeroPoints_.resize(bands_.size());
+    for (size_t b = 0; b < bands_.size(); ++b)
+    {
+        zeroPoints_[b] = vegaCorrection - rawCorrection(integrate(vegaTemperature, b), vegaTemperature);
+    }
+
+    // Table of corrections, integrating a batch of temperatures at a time
+    constexpr size_t lanes{detail::spectrumLanes};
+    table_.resize(tableSize * bands_.size());
+    std::array<float, lanes> inverseT;
+    std::array<std::array<float, lanes>, 1> flux;
+    for (size_t first = 0; first < tableSize; first += lanes)
+    {
+        for (size_t t = 0; t < lanes; ++t)
+        {
+            inverseT[t] = static_cast<float>(std::exp(-(logLow_ + static_cast<double>(first + t) * logStep_)));
+        }
+        for (size_t b = 0; b < bands_.size(); ++b)
+        {
+            detail::integratePlanck<1>(
+                scale_.data(), exponent_.data(), {{weights_[b].data()}}, samples, inverseT, flux);
+            for (size_t t = 0; t < lanes && first + t < tableSize; ++t)
+            {
+                const double temperature = std::exp(logLow_ + static_cast<double>(first + t) * logStep_);
+                table_[(first + t) * bands_.size() + b] =
+                    static_cast<float>(rawCorrection(flux[0][t], temperature) + zeroPoints_[b]);
+            }
+        }
+    }
+}
+
+const Photometry& Photometry::johnsonCousins()
+{
+    static const Photometry photometry{{
+        Bandpass::gaussian(365e-9, 66e-9),
+        Bandpass::gaussian(445e-9, 94e-9),
+        Bandpass::gaussian(551e-9, 88e-9),
+        Bandpass::gaussian(658e-9, 138e-9),
+        Bandpass::gaussian(806e-9, 149e-9),
+    }};
+    return photometry;
+}
+
+void Photometry::checkBand(size_t band) const
+{
+    if (band >= bands_.size())
+    {
+        throw std::out_of_range("Unknown band " + std::to_string(band));
+    }
+}
+
+double Photometry::integrate(double temperature, size_t band) const
+{
+    double flux = 0.;
+    for (size_t i = 0; i < wavelengths_.size(); ++i)
+    {
+        const double wavelength = wavelengths_[i];
+        flux += weights_[band][i] * detail::planckC1 / std::pow(wavelength, 5.) /
+                std::expm1(detail::planckC2 / (wavelength * temperature));
+    }
+    return flux;
+}
+
+double Photometry::exactBolometricCorrection(const quantity::Kelvin& temperature, size_t band) const
+{
+    checkBand(band);
+    return rawCorrection(integrate(temperature.value(), band), temperature.value()) + zeroPoints_[band];
+}
+
+double Photometry::bolometricCorrection(const quantity::Kelvin& temperature, size_t band) const
+{
+    checkBand(band);
+    if (temperature < tableLow || temperature > tableHigh)
+    {
+        return exactBolometricCorrection(temperature, band);
+    }
+
+    const double x = (std::log(temperature.value()) - logLow_) / logStep_;
+    const size_t i = std::min(static_cast<size_t>(x), tableSize - 2);
+    const double t = x - static_cast<double>(i);
+    const float lo = table_[i * bands_.size() + band];
+    const float hi = table_[(i + 1) * bands_.size() + band];
+    return lo + t * (hi - lo);
+}
+
+double Photometry::colourIndex(const quantity::Kelvin& temperature, size_t first, size_t second) const
+{
+    return bolometricCorrection(temperature, first) - bolometricCorrection(temperature, second);
+}
+
+void Photometry::bolometricCorrections(std::span<const quantity::Kelvin> temperatures,
+                                       size_t band,
+                                       std::span<float> corrections,
+                                       ThreadPool& pool) const
+{
+    if (temperatures.size() != corrections.size())
+    {
+        throw std::runtime_error("Mismatching sizes: " + std::to_string(temperatures.size()) + " temperatures for " +
+                                 std::to_string(corrections.size()) + " corrections");
+    }
+    parallelFor(
+        temperatures.size(),
+        bulkBlock,
+        [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                corrections[i] = static_cast<float>(bolometricCorrection(temperatures[i], band));
+            }
+        },
+        pool);
+}
+
+void Photometry::colourIndices(std::span<const quantity::Kelvin> temperatures,
+                               size_t first,
+                               size_t second,
+                               std::span<float> indices,
+                               ThreadPool& pool) const
+{
+    if (temperatures.size() != indices.size())
+    {
+        throw std::runtime_error("Mismatching sizes: " + std::to_string(temperatures.size()) + " temperatures for " +
+                                 std::to_string(indices.size()) + " indices");
+    }
+    parallelFor(
+        temperatures.size(),
+        bulkBlock,
+        [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                indices[i] = static_cast<float>(colourIndex(temperatures[i], first, second));
+            }
+        },
+        pool);
+}
+
+} // namespace math
+} // namespace galaxias
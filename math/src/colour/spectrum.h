@@ -0,0 +1,62 @@
+#pragma once
+
+#include "fast_math.h"
+
+#include <array>
+
+namespace galaxias
+{
+namespace math
+{
+namespace detail
+{
+
+/// Number of temperatures integrated together, sized so that the lanes loops map onto SIMD registers
+constexpr size_t spectrumLanes{16};
+
+/// Planck's law constants for spectral radiance in terms of wavelength
+constexpr double planckC1{3.74183e-16};
+constexpr double planckC2{1.4388e-2};
+
+/// Integrate a black body spectrum against C response curves, for spectrumLanes temperatures at once:
+///     sums[c][t] = sum_i weights[c][i] * scale[i] / (exp(exponent[i] * inverseT[t]) - 1)
+/// where scale = c1 * lambda^-5 (times the sample width if needed) and exponent = c2 / lambda for each sample.
+/// Samples whose exponential overflows fastExp count as 0: at temperatures where all of them do, the sums are 0 and the
+/// caller has to integrate in double precision instead
+template <size_t C>
+void integratePlanck(const float* scale,
+                     const float* exponent,
+                     const std::array<const float*, C>& weights,
+                     size_t samples,
+                     const std::array<float, spectrumLanes>& inverseT,
+                     std::array<std::array<float, spectrumLanes>, C>& sums)
+{
+    for (auto& channel : sums)
+    {
+        channel.fill(0.f);
+    }
+    for (size_t i = 0; i < samples; ++i)
+    {
+        std::array<float, spectrumLanes> intensity;
+        for (size_t t = 0; t < spectrumLanes; ++t)
+        {
+            // Positive, so comparing as integers works
+            const float x = exponent[i] * inverseT[t];
+            intensity[t] = select(std::bit_cast<int32_t>(x) > std::bit_cast<int32_t>(fastExpHigh),
+                                  0.f,
+                                  scale[i] / (fastExp(x) - 1.f));
+        }
+        for (size_t c = 0; c < C; ++c)
+        {
+            const float w = weights[c][i];
+            for (size_t t = 0; t < spectrumLanes; ++t)
+            {
+                sums[c][t] += w * intensity[t];
+            }
+        }
+    }
+}
+
+} // namespace detail
+} // namespace math
+} // namespace galaxias
@@ -0,0 +1,54 @@
+#include <math/rng/prng.h>
+
+namespace galaxias
+{
+namespace math
+{
+namespace rng
+{
+
+namespace
+{
+
+constexpr uint64_t golden{0x9e3779b97f4a7c15};
+
+inline uint64_t mix64(uint64_t z)
+{
+    // Finaliser of splitmix64, see https://prng.di.unimi.it/splitmix64.c
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+inline uint64_t fmix64(uint64_t z)
+{
+    // Finaliser of murmur3, different constants so the two stages do not cancel out
+    z = (z ^ (z >> 33)) * 0xff51afd7ed558ccd;
+    z = (z ^ (z >> 33)) * 0xc4ceb9fe1a85ec53;
+    return z ^ (z >> 33);
+}
+
+} // namespace
+
+namespace detail
+{
+
+SplitMixCounter::SplitMixCounter(uint64_t key, uint64_t stream, uint64_t index)
+    : key_{mix64(mix64(key + golden) + (stream + 1) * golden)}
+    , index_{index}
+{
+}
+
+uint64_t SplitMixCounter::at(uint64_t index) const { return mix64(key_ ^ fmix64((index + 1) * golden)); }
+
+} // namespace detail
+
+template <>
+Keyed::PRNG(uint64_t seed)
+    : generator_{seed}
+{
+}
+
+} // namespace rng
+} // namespace math
+} // namespace galaxias
@@ -1,7 +1,11 @@
 #include <math/colour/colour.h>
 
+#include "../src/colour/fast_math.h"
+
 #include <catch2/catch.hpp>
 
+#include <algorithm>
+
 using namespace galaxias;
 using namespace math;
 
@@ -68,3 +72,165 @@ TEST_CASE("Blackbody colour")
     check(blackBodyColour(9500.f), 0.815624f, 0.859485f, 1.f);
     check(blackBodyColour(10000.f), 0.798351f, 0.848102f, 1.f);
 }
+
+TEST_CASE("Blackbody colour lookup matches integration")
+{
+    // Dense log-spaced sweep, including points between table nodes and out of the table
+    float maxError = 0.f;
+    float maxErrorSmooth = 0.f;
+    for (double logT = std::log(300.); logT < std::log(120000.); logT += 0.0003)
+    {
+        const double t = std::exp(logT);
+        const Colour exact = blackBodyColour(t);
+        const Colour lookup = blackBodyColourLookup(t);
+        const float error = std::max({std::abs(exact.r() - lookup.r()),
+                                      std::abs(exact.g() - lookup.g()),
+                                      std::abs(exact.b() - lookup.b())});
+        maxError = std::max(maxError, error);
+        // Away from the kinks of the gamut clipping, up to the end of the table
+        if ((t > 1000. && t < 1800.) || (t > 2000. && t < 6400.) || (t > 6700. && t < 100000.))
+        {
+            maxErrorSmooth = std::max(maxErrorSmooth, error);
+        }
+    }
+    INFO(maxError << " " << maxErrorSmooth);
+    CHECK(maxError < 1e-3f);
+    CHECK(maxErrorSmooth < 2e-5f);
+}
+
+TEST_CASE("Batched blackbody colours match integration")
+{
+    // Not a multiple of the batch size, to check the padding. Starts cold enough for the exponential to overflow
+    std::vector<quantity::Kelvin> temperatures;
+    for (double t = 150.; t < 60000.; t *= 1.13)
+    {
+        temperatures.emplace_back(t);
+    }
+    std::vector<Colour> colours(temperatures.size(), Colour{0., 0., 0.});
+    blackBodyColours(temperatures, colours);
+
+    for (size_t i = 0; i < temperatures.size(); ++i)
+    {
+        const Colour exact = blackBodyColour(temperatures[i]);
+        INFO(temperatures[i].value());
+        CHECK(colours[i].r() == Approx(exact.r()).margin(1e-5));
+        CHECK(colours[i].g() == Approx(exact.g()).margin(1e-5));
+        CHECK(colours[i].b() == Approx(exact.b()).margin(1e-5));
+        CHECK(colours[i].a() == 1.f);
+    }
+
+    std::vector<Colour> tooShort(temperatures.size() - 1, Colour{0., 0., 0.});
+    CHECK_THROWS_AS(blackBodyColours(temperatures, tooShort), std::runtime_error);
+}
+
+TEST_CASE("Fast exponential")
+{
+    for (float x = -87.f; x < 88.f; x += 0.05f)
+    {
+        INFO(x);
+        CHECK(detail::fastExp(x) == Approx(std::exp(x)).epsilon(5e-7));
+    }
+
+    // Out of range values are clamped
+    CHECK(detail::fastExp(-1000.f) == Approx(std::exp(-87.f)).epsilon(5e-7));
+    CHECK(detail::fastExp(1000.f) == Approx(std::exp(88.f)).epsilon(5e-7));
+}
+
+TEST_CASE("Colour as hex without allocation")
+{
+    for (const auto& col : {Colour(0., 0., 0., 0.), Colour(0., 0.5, 0.), Colour(0.2, 0.4, 0.6, 0.8)})
+    {
+        std::array<char, Colour::hexSize> buffer;
+        col.hex(buffer);
+        CHECK(std::string(buffer.data()) == col.hex());
+    }
+}
+
+TEST_CASE("Colour packed formats")
+{
+    CHECK(Colour(0., 0., 0., 0.).rgba8() == 0x00000000);
+    CHECK(Colour(1., 1., 1., 1.).rgba8() == 0xffffffff);
+    CHECK(Colour(0.2, 0.4, 0.6, 0.8).rgba8() == 0xcc996633);
+    // Rounded to nearest, unlike hex
+    CHECK(Colour(0., 0.5, 0.).rgba8() == 0xff008000);
+
+    CHECK(Colour(0., 0.5, 1., 0.2).rgba16f() == std::array<uint16_t, 4>{{0x0000, 0x3800, 0x3c00, 0x3266}});
+    // Subnormal and round to nearest even
+    CHECK(Colour(3e-5f, 1.f / 3.f, 2e-4f, 0.99999f).rgba16f() ==
+          std::array<uint16_t, 4>{{0x01f7, 0x3555, 0x0a8e, 0x3c00}});
+}
+
+TEST_CASE("Colours packed into buffers")
+{
+    const std::vector<Colour> colours{Colour(0.2, 0.4, 0.6, 0.8), Colour(1., 0., 0.5, 1.)};
+    Owning1DArray<uint32_t> buffer;
+    packRGBA8(colours, buffer);
+    REQUIRE(buffer.size() == 2);
+    CHECK(buffer[0] == 0xcc996633);
+    CHECK(buffer[1] == 0xff8000ff);
+
+    packRGBA16F(colours, buffer);
+    REQUIRE(buffer.size() == 4);
+    CHECK(buffer[2] == 0x00003c00);
+    CHECK(buffer[3] == 0x3c003800);
+
+    // Smaller contents reuse the buffer
+    const auto data = buffer.data();
+    packRGBA8(colours, buffer);
+    CHECK(buffer.data() == data);
+    CHECK(buffer.size() == 2);
+}
+
+TEST_CASE("Fast logarithm and sRGB gamma")
+{
+    for (float x = 1e-6f; x < 1e6f; x *= 1.01f)
+    {
+        INFO(x);
+        CHECK(detail::fastLog(x) == Approx(std::log(x)).margin(2e-7));
+    }
+    for (float c = -0.5f; c < 3.f; c += 0.001f)
+    {
+        INFO(c);
+        const float exact = c <= 0.0031308f ? 12.92f * c : 1.055f * std::pow(c, 1.f / 2.4f) - 0.055f;
+        CHECK(detail::srgbGamma(c) == Approx(exact).epsilon(1e-6).margin(1e-7));
+    }
+}
+
+TEST_CASE("Batched XYZ to sRGB")
+{
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    for (float i = 0.f; i <= 1.f; i += 0.05f)
+    {
+        for (float j = 0.f; j <= 1.f; j += 0.05f)
+        {
+            for (float k = 0.f; k <= 1.f; k += 0.1f)
+            {
+                x.push_back(i);
+                y.push_back(j);
+                z.push_back(k);
+            }
+        }
+    }
+
+    ThreadPool pool{3};
+    std::vector<Colour> colours(x.size(), Colour{0., 0., 0.});
+    coloursFromXYZ(x, y, z, colours, pool);
+    Owning1DArray<uint32_t> image;
+    rgba8FromXYZ(x, y, z, image, pool);
+    REQUIRE(image.size() == x.size());
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        const Colour exact = Colour::fromXYZ(x[i], y[i], z[i]);
+        INFO(x[i] << ", " << y[i] << ", " << z[i]);
+        CHECK(colours[i].r() == Approx(exact.r()).margin(1e-5));
+        CHECK(colours[i].g() == Approx(exact.g()).margin(1e-5));
+        CHECK(colours[i].b() == Approx(exact.b()).margin(1e-5));
+        CHECK(image[i] == colours[i].rgba8());
+    }
+
+    CHECK_THROWS_AS(coloursFromXYZ(x, y, std::span<const float>(z).subspan(1), colours), std::runtime_error);
+    CHECK_THROWS_AS(rgba8FromXYZ(std::span<const float>(x).subspan(1), y, z, image), std::runtime_error);
+    CHECK(image.size() == x.size());
+}
@@ -0,0 +1,97 @@
+#include <math/colour/photometry.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+
+using namespace galaxias;
+using namespace math;
+
+TEST_CASE("Bandpass transmission")
+{
+    const Bandpass band{500e-9, 10e-9, {0.f, 1.f, 0.5f}};
+    CHECK(band.first().value() == Approx(500e-9));
+    CHECK(band.last().value() == Approx(520e-9));
+    CHECK(band.transmission(490e-9) == 0.f);
+    CHECK(band.transmission(500e-9) == 0.f);
+    CHECK(band.transmission(505e-9) == Approx(0.5f));
+    CHECK(band.transmission(510e-9) == Approx(1.f));
+    CHECK(band.transmission(515e-9) == Approx(0.75f));
+    CHECK(band.transmission(530e-9) == 0.f);
+    CHECK_THROWS_AS(Bandpass(500e-9, 10e-9, {1.f}), std::runtime_error);
+
+    const auto gaussian = Bandpass::gaussian(550e-9, 100e-9);
+    CHECK(gaussian.transmission(550e-9) == Approx(1.f));
+    CHECK(gaussian.transmission(500e-9) == Approx(0.5f).epsilon(1e-3));
+    CHECK(gaussian.transmission(600e-9) == Approx(0.5f).epsilon(1e-3));
+    CHECK(gaussian.transmission(300e-9) == 0.f);
+}
+
+TEST_CASE("Johnson-Cousins photometry of black bodies")
+{
+    const auto& photometry = Photometry::johnsonCousins();
+    REQUIRE(photometry.bands() == 5);
+
+    // Vega-like black body is at colour 0
+    for (size_t b = 0; b < photometry.bands(); ++b)
+    {
+        CHECK(photometry.bolometricCorrection(9600., b) == Approx(-0.25).margin(2e-4));
+    }
+    CHECK(photometry.colourIndex(9600., JohnsonBand::B, JohnsonBand::V) == Approx(0.).margin(2e-4));
+
+    // Sun-like black body is redder, hotter stars are bluer
+    const double sunBV = photometry.colourIndex(5778., JohnsonBand::B, JohnsonBand::V);
+    CHECK(sunBV > 0.4);
+    CHECK(sunBV < 0.8);
+    double previous = std::numeric_limits<double>::max();
+    for (double t = 1500.; t < 80000.; t *= 1.3)
+    {
+        const double bv = photometry.colourIndex(t, JohnsonBand::B, JohnsonBand::V);
+        CHECK(bv < previous);
+        previous = bv;
+    }
+
+    CHECK_THROWS_AS(photometry.bolometricCorrection(5000., 5), std::out_of_range);
+}
+
+TEST_CASE("Photometry table matches exact integration")
+{
+    const auto& photometry = Photometry::johnsonCousins();
+    double maxError = 0.;
+    for (double logT = std::log(800.); logT < std::log(120000.); logT += 0.0011)
+    {
+        const double t = std::exp(logT);
+        for (size_t b = 0; b < photometry.bands(); ++b)
+        {
+            maxError = std::max(
+                maxError, std::abs(photometry.bolometricCorrection(t, b) - photometry.exactBolometricCorrection(t, b)));
+        }
+    }
+    INFO(maxError);
+    CHECK(maxError < 2e-4);
+}
+
+TEST_CASE("Bulk photometry")
+{
+    const auto& photometry = Photometry::johnsonCousins();
+    std::vector<quantity::Kelvin> temperatures;
+    for (size_t i = 0; i < 10000; ++i)
+    {
+        temperatures.emplace_back(2000. + 3. * static_cast<double>(i));
+    }
+
+    ThreadPool pool{3};
+    std::vector<float> corrections(temperatures.size());
+    photometry.bolometricCorrections(temperatures, 2, corrections, pool);
+    std::vector<float> indices(temperatures.size());
+    photometry.colourIndices(temperatures, 1, 2, indices, pool);
+    for (size_t i = 0; i < temperatures.size(); i += 97)
+    {
+        CHECK(corrections[i] == Approx(photometry.bolometricCorrection(temperatures[i], 2)));
+        CHECK(indices[i] == Approx(photometry.colourIndex(temperatures[i], 1, 2)).margin(1e-6));
+    }
+
+    CHECK_THROWS_AS(photometry.colourIndices(temperatures, 1, 7, indices, pool), std::out_of_range);
+    indices.pop_back();
+    CHECK_THROWS_AS(photometry.colourIndices(temperatures, 1, 2, indices), std::runtime_error);
+}
@@ -0,0 +1,101 @@
+#include <math/rng/prng.h>
+
+#include <math/range.h>
+
+#include <catch2/catch.hpp>
+
+using namespace galaxias;
+using namespace math;
+using namespace rng;
+
+namespace
+{
+constexpr Range<double> range(10., 20.);
+constexpr Range<size_t> intRange(15, 30);
+
+} // namespace
+
+TEST_CASE("Keyed with seed")
+{
+    Keyed m{42};
+
+    // m produces deterministic outputs
+    CHECK(m.uniform() == 6244793992194727596ull);
+    CHECK(m.uniform() == 4579132818492964779ull);
+    CHECK(m.uniform(range) == Approx(18.7430079411));
+    CHECK(m.gaussian<double>() == Approx(-0.2991524774));
+    CHECK(m.uniform(intRange) == 17);
+}
+
+TEST_CASE("Keyed counter has random access")
+{
+    detail::SplitMixCounter counter{42, 7};
+    std::vector<uint64_t> sequence;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        sequence.push_back(counter());
+    }
+    CHECK(counter.index() == 100);
+
+    // Any output can be retrieved directly, in any order
+    for (size_t i = 100; i > 0; --i)
+    {
+        INFO(i);
+        CHECK(counter.at(i - 1) == sequence[i - 1]);
+    }
+
+    // Seeking and discarding move the counter only
+    counter.seek(10);
+    CHECK(counter() == sequence[10]);
+    counter.discard(20);
+    CHECK(counter() == sequence[31]);
+
+    // A fresh counter starting at an index continues the same sequence
+    detail::SplitMixCounter other{42, 7, 50};
+    CHECK(other() == sequence[50]);
+}
+
+TEST_CASE("Keyed streams are independent")
+{
+    // Same key with other streams, or other keys, must not produce the same outputs
+    detail::SplitMixCounter reference{42, 0};
+    detail::SplitMixCounter otherStream{42, 1};
+    detail::SplitMixCounter otherKey{43, 0};
+    detail::SplitMixCounter shifted{42 + 0x9e3779b97f4a7c15, 0};
+    size_t equal = 0;
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        const auto x = reference.at(i);
+        equal += (x == otherStream.at(i)) + (x == otherKey.at(i)) + (x == shifted.at(i)) + (x == reference.at(i + 1));
+    }
+    CHECK(equal == 0);
+
+    // And the distribution of bits stays balanced
+    constexpr size_t samples{1 << 16};
+    std::array<size_t, 64> ones{};
+    for (uint64_t i = 0; i < samples; ++i)
+    {
+        const auto x = Keyed{detail::SplitMixCounter{i, i % 3}}.uniform();
+        for (size_t b = 0; b < 64; ++b)
+        {
+            ones[b] += (x >> b) & 1;
+        }
+    }
+    for (size_t b = 0; b < 64; ++b)
+    {
+        INFO(b);
+        CHECK(static_cast<double>(ones[b]) / samples == Approx(0.5).margin(0.01));
+    }
+}
+
+TEST_CASE("Keyed from existing and mask")
+{
+    constexpr int64_t mask = 0x7777777777777777;
+    Random m{42};
+    Keyed n{m, mask};
+
+    // m has been updated in the process
+    CHECK(m.uniform() == 9106390978755430941ull);
+    // n produces deterministic outputs
+    CHECK(n.uniform() == 4538164326677589133ull);
+}
@@ -3,6 +3,8 @@
 #include <catch2/catch.hpp>
 #include <math/rng/prng.h>
 
+#include <numeric>
+
 using namespace galaxias;
 using namespace math;
 
@@ -92,3 +94,94 @@ TEST_CASE("Shuffle with an arbitrary RNG")
     const std::vector<int> expected = {8, 7, 3, 9, 11, 10, 17, 0, 14, 16, 2, 5, 1, 12, 4, 13, 20, 15, 19, 6, 18};
     CHECK(values2 == expected);
 }
+
+TEST_CASE("Batched shuffle with an arbitrary RNG")
+{
+    auto values2 = values;
+    math::rng::Random random(1);
+    rng::batchedShuffle(values2.begin(), values2.end(), random);
+    const std::vector<int> expected = {13, 9, 15, 4, 2, 10, 0, 20, 18, 11, 3, 12, 14, 7, 17, 16, 1, 19, 6, 5, 8};
+    CHECK(values2 == expected);
+
+    // Still a permutation
+    std::sort(values2.begin(), values2.end());
+    CHECK(values2 == values);
+}
+
+TEST_CASE("Batched shuffle is uniform")
+{
+    constexpr size_t size{5};
+    constexpr size_t samples{50000};
+    math::rng::Random random(7);
+    std::array<std::array<size_t, size>, size> counts{};
+    for (size_t s = 0; s < samples; ++s)
+    {
+        std::array<size_t, size> v{0, 1, 2, 3, 4};
+        rng::batchedShuffle(v.begin(), v.end(), random);
+        for (size_t i = 0; i < size; ++i)
+        {
+            ++counts[v[i]][i];
+        }
+    }
+    for (size_t v = 0; v < size; ++v)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            INFO(v << " at " << i);
+            CHECK(static_cast<double>(counts[v][i]) / samples == Approx(1. / size).margin(0.01));
+        }
+    }
+}
+
+TEST_CASE("Parallel shuffle does not depend on threads count")
+{
+    std::vector<uint32_t> reference(300000);
+    std::iota(reference.begin(), reference.end(), 0);
+    auto single = reference;
+    ThreadPool singlePool{1};
+    rng::parallelShuffle(single.begin(), single.end(), 42, singlePool);
+    CHECK(single != reference);
+
+    for (size_t threads : {2, 3, 8})
+    {
+        INFO(threads);
+        ThreadPool pool{threads};
+        auto multi = reference;
+        rng::parallelShuffle(multi.begin(), multi.end(), 42, pool);
+        CHECK(multi == single);
+    }
+
+    // Another seed gives another permutation
+    auto other = reference;
+    rng::parallelShuffle(other.begin(), other.end(), 43);
+    CHECK(other != single);
+
+    std::sort(single.begin(), single.end());
+    CHECK(single == reference);
+}
+
+TEST_CASE("Parallel shuffle is uniform across blocks")
+{
+    // Tiny blocks so that every element goes through several merges
+    constexpr size_t size{6};
+    constexpr size_t samples{60000};
+    std::array<std::array<size_t, size>, size> counts{};
+    ThreadPool pool{2};
+    for (size_t s = 0; s < samples; ++s)
+    {
+        std::array<size_t, size> v{0, 1, 2, 3, 4, 5};
+        rng::parallelShuffle(v.begin(), v.end(), s, pool, 2);
+        for (size_t i = 0; i < size; ++i)
+        {
+            ++counts[v[i]][i];
+        }
+    }
+    for (size_t v = 0; v < size; ++v)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            INFO(v << " at " << i);
+            CHECK(static_cast<double>(counts[v][i]) / samples == Approx(1. / size).margin(0.01));
+        }
+    }
+}
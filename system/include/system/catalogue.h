@@ -0,0 +1,124 @@
+#pragma once
+
+#include "generator.h"
+#include "system.h"
+
+#include <core/mapped_array.h>
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace galaxias
+{
+namespace system
+{
+
+namespace catalogue
+{
+
+static_assert(std::endian::native == std::endian::little, "Catalogues are stored little endian");
+
+/// Catalogue layout: header, systems sorted by identifier, their stars in the same order, their names, then the sparse
+/// index holding the identifier of every indexStride-th system. Sections start on 8 bytes boundaries
+constexpr std::array<char, 8> magic{{'G', 'X', 'C', 'A', 'T', 'L', 'G', '\0'}};
+constexpr uint32_t version{1};
+
+struct Header
+{
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t indexStride;
+    uint64_t systemCount;
+    uint64_t starCount;
+    uint64_t systemsOffset;
+    uint64_t starsOffset;
+    uint64_t namesOffset;
+    uint64_t namesSize;
+    uint64_t indexOffset;
+};
+
+struct SystemRecord
+{
+    uint64_t identifier;
+    /// Galactic coordinates in radians, kly and kly
+    float angle;
+    float radius;
+    float height;
+    /// Stars are [firstStar, firstStar + starCount) in the stars section
+    uint32_t firstStar;
+    /// Name is [nameOffset, nameOffset + nameSize) in the names section
+    uint32_t nameOffset;
+    uint16_t starCount;
+    uint16_t nameSize;
+};
+
+static_assert(sizeof(Header) == 72 && sizeof(SystemRecord) == 32, "Catalogue structures must have no padding");
+
+} // namespace catalogue
+
+/// Builds a catalogue in memory and writes it in one go
+class CatalogueWriter
+{
+public:
+    explicit CatalogueWriter(uint32_t indexStride = 64);
+
+    size_t size() const { return systems_.size(); }
+
+    void add(const ISystem& system);
+    /// Generate systems in bulk and add them
+    GenerationStatistics add(const IdentifierSet& identifiers, const GalaxyGenerator& generator = GalaxyGenerator{});
+
+    /// Throws std::runtime_error on duplicate systems
+    void write(const std::filesystem::path& path) const;
+
+private:
+    uint32_t indexStride_;
+    std::vector<catalogue::SystemRecord> systems_;
+    std::vector<StarSummary> stars_;
+    std::string names_;
+};
+
+/// Read-only catalogue, memory-mapped: opening costs one open, lookups are binary searches in the sparse index then
+/// within a stride of systems. Records, stars and names are views on the mapping, without reads or copies
+class Catalogue
+{
+public:
+    using Record = catalogue::SystemRecord;
+
+    /// Throws std::runtime_error if the file isn't a valid catalogue
+    explicit Catalogue(const std::filesystem::path& path);
+
+    size_t size() const { return systems_.size(); }
+    std::span<const Record> systems() const { return systems_; }
+
+    /// Record of an identifier value, nullptr if not in the catalogue
+    const Record* find(uint64_t identifier) const;
+    /// Records with identifier values in [first, last)
+    std::span<const Record> range(uint64_t first, uint64_t last) const;
+
+    /// Throw std::out_of_range if the record points out of the catalogue
+    std::span<const StarSummary> stars(const Record& record) const;
+    std::string_view name(const Record& record) const;
+    SystemSummary summary(const Record& record) const;
+
+private:
+    /// Position of the first record with an identifier not less than the given one
+    size_t lowerBound(uint64_t identifier) const;
+
+private:
+    MappedFile file_;
+    uint32_t indexStride_;
+    std::span<const Record> systems_;
+    std::span<const StarSummary> stars_;
+    std::span<const char> names_;
+    std::span<const uint64_t> index_;
+};
+
+} // namespace system
+} // namespace galaxias
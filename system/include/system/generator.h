@@ -0,0 +1,128 @@
+#pragma once
+
+#include "region.h"
+#include "system.h"
+#include "system_identifier.h"
+
+#include <core/thread_pool.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace galaxias
+{
+namespace system
+{
+
+/// Identifier values to generate: a contiguous range [first, last), an explicit list or rectangles of candidates
+class IdentifierSet
+{
+public:
+    IdentifierSet(uint64_t first, uint64_t last);
+    IdentifierSet(std::vector<uint64_t> values);
+    IdentifierSet(std::vector<IdentifierRectangle> rectangles);
+
+    /// Every system of the galaxy
+    static IdentifierSet all() { return {0, SystemIdentifier::valueCount}; }
+    /// Systems which may lie in a sector, see candidateIdentifiers()
+    static IdentifierSet candidates(const GalacticSector& sector) { return {candidateIdentifiers(sector)}; }
+
+    size_t size() const { return size_; }
+    uint64_t operator[](size_t i) const
+    {
+        return !rectangles_.empty() ? inRectangles(i) : values_.empty() ? first_ + i : values_[i];
+    }
+
+private:
+    uint64_t inRectangles(size_t i) const;
+
+private:
+    uint64_t first_;
+    uint64_t last_;
+    size_t size_;
+    std::vector<uint64_t> values_;
+    std::vector<IdentifierRectangle> rectangles_;
+    /// Index of the first identifier of each rectangle
+    std::vector<size_t> offsets_;
+};
+
+struct GenerationStatistics
+{
+    size_t systems;
+    double seconds;
+
+    double systemsPerSecond() const { return seconds > 0. ? static_cast<double>(systems) / seconds : 0.; }
+};
+
+/// Consumers of generated systems. Batches are consecutive and follow the order of the identifier set
+using SystemSink = std::function<void(std::span<const SystemSummary>)>;
+using FullSystemSink = std::function<void(std::span<const std::shared_ptr<const ISystem>>)>;
+
+/// Generate many systems in parallel, streaming their summaries to a sink.
+/// Batches are generated ahead on the pool and delivered in order from the calling thread, so the output only depends
+/// on the identifiers, not on the number of threads. Generation goes on while the sink consumes the previous batches
+class GalaxyGenerator
+{
+public:
+    explicit GalaxyGenerator(ThreadPool& pool = ThreadPool::global(), size_t batchSize = 1024);
+
+    GenerationStatistics generate(const IdentifierSet& identifiers, const SystemSink& sink) const;
+    /// Hand over the systems themselves, with all their properties generated
+    GenerationStatistics generateSystems(const IdentifierSet& identifiers, const FullSystemSink& sink) const;
+
+private:
+    template <class T>
+    GenerationStatistics run(const IdentifierSet& identifiers,
+                             const std::function<T(std::unique_ptr<ISystem>)>& make,
+                             const std::function<void(std::span<const T>)>& sink) const;
+
+private:
+    ThreadPool& pool_;
+    size_t batchSize_;
+};
+
+/// Sink writing raw summaries to a file, which can be read back as an array of SystemSummary
+class SummaryFileSink
+{
+public:
+    explicit SummaryFileSink(const std::filesystem::path& path);
+
+    void operator()(std::span<const SystemSummary> summaries);
+
+    size_t written() const { return written_; }
+
+private:
+    std::ofstream ofs_;
+    size_t written_;
+};
+
+/// Bounded queue of batches, to consume generated systems from another thread.
+/// Producers block while the queue is full; pop() returns nothing once the queue is closed and drained
+class SummaryQueue
+{
+public:
+    explicit SummaryQueue(size_t capacity = 16);
+
+    void operator()(std::span<const SystemSummary> summaries);
+    std::optional<std::vector<SystemSummary>> pop();
+    void close();
+
+private:
+    const size_t capacity_;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::deque<std::vector<SystemSummary>> batches_;
+    bool closed_;
+};
+
+} // namespace system
+} // namespace galaxias
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "system.h"
+
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <vector>
+
+namespace galaxias
+{
+namespace system
+{
+
+/// Cartesian position in the galactic frame, in kly: x towards angle 0, z along the height
+struct GalacticPosition
+{
+    float x;
+    float y;
+    float z;
+
+    static GalacticPosition of(const SystemSummary& summary);
+
+    float distanceSquared(const GalacticPosition& other) const;
+};
+
+/// Region of the galaxy in galactocentric coordinates: angles in radians within [angleLow, angleHigh], wrapping past
+/// 2 pi when angleLow > angleHigh, radii and heights in kly
+struct GalacticSector
+{
+    double angleLow{0.};
+    double angleHigh{2. * std::numbers::pi};
+    double radiusLow{0.};
+    double radiusHigh{std::numeric_limits<double>::infinity()};
+    double heightLow{-std::numeric_limits<double>::infinity()};
+    double heightHigh{std::numeric_limits<double>::infinity()};
+
+    /// Smallest sector holding a box given by its lowest and highest corners
+    static GalacticSector bounding(const GalacticPosition& low, const GalacticPosition& high);
+
+    bool contains(const orbit::coordinates::GalactoCentric& coordinates) const;
+};
+
+/// Raw identifier coordinates (see SystemIdentifier) with angles in [angleFirst, angleLast) and radii in
+/// [radiusFirst, radiusLast). Whole rows of angles are contiguous identifier values
+struct IdentifierRectangle
+{
+    uint32_t angleFirst;
+    uint32_t angleLast;
+    uint32_t radiusFirst;
+    uint32_t radiusLast;
+
+    uint64_t size() const
+    {
+        return static_cast<uint64_t>(angleLast - angleFirst) * static_cast<uint64_t>(radiusLast - radiusFirst);
+    }
+    /// Identifier value of the i-th system, radius-major
+    uint64_t operator[](uint64_t i) const;
+};
+
+/// Identifiers of all systems which may lie in a sector, computed by inverting the generation of coordinates.
+/// Every system in the sector is guaranteed to be covered, but some candidates may lie outside
+std::vector<IdentifierRectangle> candidateIdentifiers(const GalacticSector& sector);
+
+} // namespace system
+} // namespace galaxias
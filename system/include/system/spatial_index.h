@@ -0,0 +1,88 @@
+#pragma once
+
+#include "region.h"
+#include "system.h"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <span>
+#include <vector>
+
+namespace galaxias
+{
+namespace system
+{
+
+/// Half-space a * x + b * y + c * z + d >= 0, i.e. the normal points inside
+struct Plane
+{
+    float a;
+    float b;
+    float c;
+    float d;
+};
+
+/// Index of system positions for neighbourhood queries, filled incrementally as systems are generated.
+/// Systems are bucketed in cubic cells kept in a map ordered by Morton code, which makes it an implicit octree:
+/// queries descend from the whole galaxy, skipping empty or disjoint nodes with one map lookup each
+class SpatialIndex
+{
+public:
+    struct Entry
+    {
+        uint64_t identifier;
+        GalacticPosition position;
+    };
+
+    /// Cell size in kly, which should be of the order of typical query radii
+    explicit SpatialIndex(float cellSize = 0.05f);
+
+    float cellSize() const { return cellSize_; }
+    size_t size() const { return size_; }
+
+    void insert(uint64_t identifier, const GalacticPosition& position);
+    void insert(std::span<const SystemSummary> summaries);
+
+    /// Entries within a distance (in kly) of a position, in no particular order
+    std::vector<Entry> withinRadius(const GalacticPosition& centre, float radius) const;
+    /// Up to count entries closest to a position, by increasing distance
+    std::vector<Entry> nearest(const GalacticPosition& centre, size_t count) const;
+    /// Entries inside a convex volume, e.g. the 6 planes of a view frustum
+    std::vector<Entry> inside(std::span<const Plane> planes) const;
+
+private:
+    enum class Overlap
+    {
+        Outside,
+        Partial,
+        Inside,
+    };
+
+    struct Box
+    {
+        GalacticPosition low;
+        GalacticPosition high;
+    };
+
+    using Classify = std::function<Overlap(const Box&)>;
+    using Contains = std::function<bool(const GalacticPosition&)>;
+
+    uint64_t cellCode(const GalacticPosition& position) const;
+    void query(const Classify& classify, const Contains& contains, std::vector<Entry>& result) const;
+    void descend(uint32_t level,
+                 uint32_t x,
+                 uint32_t y,
+                 uint32_t z,
+                 const Classify& classify,
+                 const Contains& contains,
+                 std::vector<Entry>& result) const;
+
+private:
+    float cellSize_;
+    size_t size_;
+    std::map<uint64_t, std::vector<Entry>> cells_;
+};
+
+} // namespace system
+} // namespace galaxias
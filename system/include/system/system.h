@@ -3,13 +3,45 @@
 #include "body.h"
 #include "system_identifier.h"
 
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace galaxias
 {
 namespace system
 {
 
+/// Compact summary of a generated system, small enough to bake whole regions of the galaxy
+struct SystemSummary
+{
+    uint64_t identifier;
+    /// Galactic coordinates in radians, kly and kly
+    float angle;
+    float radius;
+    float height;
+    uint32_t stars;
+    /// Most massive star, in solar masses and kelvins
+    float primaryMass;
+    float primaryTemperature;
+
+    bool operator==(const SystemSummary&) const = default;
+};
+static_assert(sizeof(SystemSummary) == 32);
+
+/// Compact description of a star, in solar units and kelvins
+struct StarSummary
+{
+    float mass;
+    float radius;
+    float temperature;
+    float luminosity;
+
+    bool operator==(const StarSummary&) const = default;
+};
+static_assert(sizeof(StarSummary) == 16);
+
 class ISystem
 {
 public:
@@ -18,6 +50,12 @@ public:
     static std::unique_ptr<ISystem> create(SystemIdentifier&& identifier);
 
     virtual const orbit::coordinates::GalactoCentric& galacticCoords() const = 0;
+    virtual const std::string& name() const = 0;
+    virtual size_t starsCount() const = 0;
+    virtual std::vector<StarSummary> stars() const = 0;
+    virtual SystemSummary summary() const = 0;
+    /// Approximate memory used once every property is generated, in bytes
+    virtual size_t memoryUsage() const = 0;
 };
 
 } // namespace system
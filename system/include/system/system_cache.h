@@ -0,0 +1,100 @@
+#pragma once
+
+#include "system.h"
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace galaxias
+{
+namespace system
+{
+
+/// Thread-safe cache of generated systems keyed by identifier value, within a memory budget.
+/// Systems are spread over shards, each with its own lock and least recently used list, under a budget shared by all
+/// of them: a shard over its share keeps its systems while the whole cache has room. Once over budget, systems are
+/// evicted from the shard being accessed first, then from the others. Systems can be pinned, e.g. around the player,
+/// to stay in the cache whatever the budget; pinned systems still count in the used bytes.
+/// Returned systems remain valid after their eviction
+class SystemCache
+{
+public:
+    struct Statistics
+    {
+        size_t hits;
+        size_t misses;
+        size_t evictions;
+        /// Systems in the cache, how many are pinned, and their approximate memory
+        size_t systems;
+        size_t pinned;
+        size_t bytes;
+    };
+
+    explicit SystemCache(size_t maxBytes = size_t{64} << 20, size_t shards = 16);
+    SystemCache(const SystemCache&) = delete;
+
+    SystemCache& operator=(const SystemCache&) = delete;
+
+    /// Budget of the whole cache, whatever the number of shards
+    size_t maxBytes() const { return maxBytes_; }
+
+    /// System of an identifier value, generated on a miss
+    std::shared_ptr<const ISystem> get(uint64_t value);
+    bool contains(uint64_t value) const;
+
+    /// Pins are counted: a system pinned twice needs to be unpinned twice
+    void pin(std::span<const uint64_t> values);
+    void unpin(std::span<const uint64_t> values);
+    void unpinAll();
+
+    /// Remove every system which is not pinned
+    void clear();
+    Statistics statistics() const;
+
+private:
+    struct Entry
+    {
+        std::shared_ptr<const ISystem> system;
+        size_t bytes;
+        size_t pins;
+        /// Position in the recently used list, valid while not pinned
+        std::list<uint64_t>::iterator use;
+    };
+
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        std::unordered_map<uint64_t, Entry> entries;
+        /// Unpinned systems, most recently used first
+        std::list<uint64_t> uses;
+        size_t bytes{0};
+        size_t hits{0};
+        size_t misses{0};
+        size_t evictions{0};
+    };
+
+    Shard& shardOf(uint64_t value) const;
+    /// Find or insert the entry of a value, with the shard locked
+    Entry& find(Shard& shard, std::unique_lock<std::mutex>& lock, uint64_t value);
+    /// Evict the least recently used systems of a locked shard while the cache is over budget
+    void evict(Shard& shard);
+    /// Evict from every shard while the cache is over budget, with no shard locked
+    void trim();
+
+private:
+    size_t maxBytes_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    /// Bytes of all the shards
+    std::atomic<size_t> bytes_;
+    /// Shard where trim() starts, rotated so that no shard is always emptied first
+    std::atomic<size_t> nextTrim_;
+};
+
+} // namespace system
+} // namespace galaxias
@@ -13,6 +13,19 @@ namespace system
 class SystemIdentifier
 {
 public:
+    /// Independently generated properties of a system, each with its own random stream
+    enum class Property : uint32_t
+    {
+        Coordinates,
+        Name,
+        Stars,
+        Planets,
+    };
+
+    /// Number of distinct raw angles and radii, and of identifier values, i.e. of systems in the galaxy
+    static constexpr uint32_t coordinateCount{1u << 18};
+    static constexpr uint64_t valueCount{uint64_t{coordinateCount} * coordinateCount};
+
     SystemIdentifier(uint32_t angle, uint32_t radius);
 
     static SystemIdentifier fromValue(uint64_t value);
@@ -23,6 +36,9 @@ public:
 
     /// Retrieve the underlying dice for this system. Careful in order of call!
     math::rng::Random& dice() { return dice_; }
+    const math::rng::Random& dice() const { return dice_; }
+    /// Retrieve a die dedicated to one property (and e.g. one body) of this system. Can be called in any order
+    math::rng::Keyed dice(Property property, uint32_t index = 0) const;
     const orbit::coordinates::GalactoCentric& coordinates() const;
 
 private:
@@ -3,12 +3,23 @@ set(objects_name ${library_name}_object)
 
 set(library_src
     include/${library_name}/body.h
+    include/${library_name}/catalogue.h
+    include/${library_name}/generator.h
+    include/${library_name}/region.h
+    include/${library_name}/spatial_index.h
     include/${library_name}/system.h
+    include/${library_name}/system_cache.h
     include/${library_name}/system_identifier.h
 )
 
 set(object_library_src
+    src/catalogue.cpp
+    src/galaxy_shape.h
+    src/generator.cpp
+    src/region.cpp
+    src/spatial_index.cpp
     src/system.cpp
+    src/system_cache.cpp
     src/system_identifier.cpp
 
     src/bodies/planet.cpp
@@ -96,7 +96,18 @@ Star::Classification Star::classification() const
     }
 }
 
-math::Colour Star::colour() const { return math::blackBodyColour(temperature_); }
+BandMagnitude Star::absoluteMagnitude(math::JohnsonBand band) const
+{
+    return BandMagnitude{absoluteMagnitude().value() +
+                         math::Photometry::johnsonCousins().bolometricCorrection(temperature_, band)};
+}
+
+double Star::colourIndex(math::JohnsonBand first, math::JohnsonBand second) const
+{
+    return math::Photometry::johnsonCousins().colourIndex(temperature_, first, second);
+}
+
+math::Colour Star::colour() const { return math::blackBodyColourLookup(temperature_); }
 
 qty::Metre Star::sphereOfInfluence() const { return qty::Metre{-1.}; }
 
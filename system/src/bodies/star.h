@@ -1,6 +1,7 @@
 #pragma once
 
 #include <math/colour/colour.h>
+#include <math/colour/photometry.h>
 #include <math/rng/prng.h>
 #include <system/body.h>
 
@@ -52,6 +53,12 @@ public:
 
     ApparentMagnitude apparentMagnitude(const Parsec& distance) const;
 
+    /// Absolute magnitude through a Johnson-Cousins filter, assuming a black body spectrum
+    BandMagnitude absoluteMagnitude(math::JohnsonBand band) const;
+
+    /// Colour index between two Johnson-Cousins filters, e.g. B - V
+    double colourIndex(math::JohnsonBand first, math::JohnsonBand second) const;
+
 private:
     /// Mass (prime value. All other derive from this one +- some noise)
     const SolarMass mass_;
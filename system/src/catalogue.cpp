@@ -0,0 +1,227 @@
+#include <system/catalogue.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace galaxias
+{
+namespace system
+{
+
+namespace
+{
+
+size_t alignUp(size_t offset, size_t alignment) { return (offset + alignment - 1) / alignment * alignment; }
+
+} // namespace
+
+CatalogueWriter::CatalogueWriter(uint32_t indexStride)
+    : indexStride_{std::max<uint32_t>(1, indexStride)}
+{
+}
+
+void CatalogueWriter::add(const ISystem& system)
+{
+    const auto summary = system.summary();
+    const auto stars = system.stars();
+    const auto& name = system.name();
+    if (stars.size() > std::numeric_limits<uint16_t>::max() || name.size() > std::numeric_limits<uint16_t>::max() ||
+        stars_.size() + stars.size() > std::numeric_limits<uint32_t>::max() ||
+        names_.size() + name.size() > std::numeric_limits<uint32_t>::max())
+    {
+        throw std::runtime_error("Catalogue is full");
+    }
+    systems_.push_back({summary.identifier,
+                        summary.angle,
+                        summary.radius,
+                        summary.height,
+                        static_cast<uint32_t>(stars_.size()),
+                        static_cast<uint32_t>(names_.size()),
+                        static_cast<uint16_t>(stars.size()),
+                        static_cast<uint16_t>(name.size())});
+    stars_.insert(stars_.end(), stars.begin(), stars.end());
+    names_ += name;
+}
+
+GenerationStatistics CatalogueWriter::add(const IdentifierSet& identifiers, const GalaxyGenerator& generator)
+{
+    return generator.generateSystems(identifiers,
+                                     [this](std::span<const std::shared_ptr<const ISystem>> systems)
+                                     {
+                                         for (const auto& system : systems)
+                                         {
+                                             add(*system);
+                                         }
+                                     });
+}
+
+void CatalogueWriter::write(const std::filesystem::path& path) const
+{
+    // Sort systems, then lay their stars and names out in the same order
+    std::vector<size_t> order(systems_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(),
+              order.end(),
+              [this](size_t a, size_t b) { return systems_[a].identifier < systems_[b].identifier; });
+
+    std::vector<catalogue::SystemRecord> systems;
+    std::vector<StarSummary> stars;
+    std::string names;
+    std::vector<uint64_t> index;
+    for (size_t i : order)
+    {
+        auto record = systems_[i];
+        if (!systems.empty() && systems.back().identifier == record.identifier)
+        {
+            throw std::runtime_error("Duplicate system " + std::to_string(record.identifier) + " in catalogue");
+        }
+        if (systems.size() % indexStride_ == 0)
+        {
+            index.push_back(record.identifier);
+        }
+        stars.insert(stars.end(),
+                     stars_.begin() + record.firstStar,
+                     stars_.begin() + record.firstStar + record.starCount);
+        names.append(names_, record.nameOffset, record.nameSize);
+        record.firstStar = static_cast<uint32_t>(stars.size() - record.starCount);
+        record.nameOffset = static_cast<uint32_t>(names.size() - record.nameSize);
+        systems.push_back(record);
+    }
+
+    const uint64_t systemsOffset = sizeof(catalogue::Header);
+    const uint64_t starsOffset = alignUp(systemsOffset + systems.size() * sizeof(catalogue::SystemRecord), 8);
+    const uint64_t namesOffset = alignUp(starsOffset + stars.size() * sizeof(StarSummary), 8);
+    const uint64_t indexOffset = alignUp(namesOffset + names.size(), 8);
+    const catalogue::Header header{catalogue::magic,
+                                   catalogue::version,
+                                   indexStride_,
+                                   systems.size(),
+                                   stars.size(),
+                                   systemsOffset,
+                                   starsOffset,
+                                   namesOffset,
+                                   names.size(),
+                                   indexOffset};
+
+    std::ofstream ofs{path, std::ios::binary};
+    if (!ofs)
+    {
+        throw std::runtime_error("Can't write " + path.string());
+    }
+    const char padding[8] = {};
+    const auto section = [&](uint64_t offset, const void* data, size_t bytes)
+    {
+        ofs.write(padding, offset - ofs.tellp());
+        ofs.write(static_cast<const char*>(data), bytes);
+    };
+    section(0, &header, sizeof(header));
+    section(header.systemsOffset, systems.data(), systems.size() * sizeof(catalogue::SystemRecord));
+    section(header.starsOffset, stars.data(), stars.size() * sizeof(StarSummary));
+    section(header.namesOffset, names.data(), names.size());
+    section(header.indexOffset, index.data(), index.size() * sizeof(uint64_t));
+    if (!ofs)
+    {
+        throw std::runtime_error("Can't write " + path.string());
+    }
+}
+
+////////////////////////////////////////////////////////////////
+
+Catalogue::Catalogue(const std::filesystem::path& path)
+    : file_{path, MappedFile::Mode::ReadOnly, MappedFile::Access::Random}
+{
+    const auto invalid = [&](const std::string& reason)
+    { return std::runtime_error("Invalid catalogue " + path.string() + ": " + reason); };
+
+    if (file_.bytes() < sizeof(catalogue::Header))
+    {
+        throw invalid("too small");
+    }
+    catalogue::Header header;
+    memcpy(&header, file_.data(), sizeof(header));
+    if (header.magic != catalogue::magic || header.version != catalogue::version)
+    {
+        throw invalid("wrong magic or version");
+    }
+    const uint64_t indexSize =
+        header.indexStride ? (header.systemCount + header.indexStride - 1) / header.indexStride : 0;
+    const auto fits = [&](uint64_t offset, uint64_t count, size_t size)
+    { return offset % 8 == 0 && offset <= file_.bytes() && count <= (file_.bytes() - offset) / size; };
+    if (header.indexStride == 0 || !fits(header.systemsOffset, header.systemCount, sizeof(Record)) ||
+        !fits(header.starsOffset, header.starCount, sizeof(StarSummary)) ||
+        !fits(header.namesOffset, header.namesSize, 1) || !fits(header.indexOffset, indexSize, sizeof(uint64_t)))
+    {
+        throw invalid("section out of the file");
+    }
+    indexStride_ = header.indexStride;
+    systems_ = {reinterpret_cast<const Record*>(file_.data() + header.systemsOffset), header.systemCount};
+    stars_ = {reinterpret_cast<const StarSummary*>(file_.data() + header.starsOffset), header.starCount};
+    names_ = {reinterpret_cast<const char*>(file_.data() + header.namesOffset), header.namesSize};
+    index_ = {reinterpret_cast<const uint64_t*>(file_.data() + header.indexOffset), indexSize};
+}
+
+size_t Catalogue::lowerBound(uint64_t identifier) const
+{
+    // Last stride starting before the identifier, then within it
+    const size_t stride = std::lower_bound(index_.begin(), index_.end(), identifier) - index_.begin();
+    if (stride == 0)
+    {
+        return 0;
+    }
+    const auto first = systems_.begin() + (stride - 1) * indexStride_;
+    const auto last = systems_.begin() + std::min(systems_.size(), stride * indexStride_);
+    return std::lower_bound(first, last, identifier, [](const Record& r, uint64_t id) { return r.identifier < id; }) -
+           systems_.begin();
+}
+
+const Catalogue::Record* Catalogue::find(uint64_t identifier) const
+{
+    const size_t i = lowerBound(identifier);
+    return i < systems_.size() && systems_[i].identifier == identifier ? &systems_[i] : nullptr;
+}
+
+std::span<const Catalogue::Record> Catalogue::range(uint64_t first, uint64_t last) const
+{
+    const size_t begin = lowerBound(first);
+    return systems_.subspan(begin, std::max(begin, lowerBound(last)) - begin);
+}
+
+std::span<const StarSummary> Catalogue::stars(const Record& record) const
+{
+    if (record.firstStar + uint64_t{record.starCount} > stars_.size())
+    {
+        throw std::out_of_range("Stars of system " + std::to_string(record.identifier) + " out of the catalogue");
+    }
+    return stars_.subspan(record.firstStar, record.starCount);
+}
+
+std::string_view Catalogue::name(const Record& record) const
+{
+    if (record.nameOffset + uint64_t{record.nameSize} > names_.size())
+    {
+        throw std::out_of_range("Name of system " + std::to_string(record.identifier) + " out of the catalogue");
+    }
+    return {names_.data() + record.nameOffset, record.nameSize};
+}
+
+SystemSummary Catalogue::summary(const Record& record) const
+{
+    const auto stars = this->stars(record);
+    SystemSummary summary{
+        record.identifier, record.angle, record.radius, record.height, static_cast<uint32_t>(stars.size()), 0.f, 0.f};
+    const auto primary = std::max_element(
+        stars.begin(), stars.end(), [](const StarSummary& a, const StarSummary& b) { return a.mass < b.mass; });
+    if (primary != stars.end())
+    {
+        summary.primaryMass = primary->mass;
+        summary.primaryTemperature = primary->temperature;
+    }
+    return summary;
+}
+
+} // namespace system
+} // namespace galaxias
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace galaxias
+{
+namespace system
+{
+namespace detail
+{
+
+/// Shape of the galaxy as a function of the raw identifier coordinates (angle, radius) plus a jitter in [0, 1).
+/// Shared by the generation of coordinates and their inverse: do not modify unless aware of the consequences !!!
+
+constexpr uint64_t identifierShift{18};
+constexpr uint32_t identifierMask = 0x3FFFF;
+constexpr double identifierMax = 262144.; // 0x40000 as integer
+
+/// Distance to the galaxy's edge: (0, 1] from the centre outwards, slightly above 1 for the very first radii
+inline double edgeDistance(double rawRadius) { return 1.000005 - rawRadius / identifierMax; }
+
+/// Radius in kly: we simulate a spiral galaxy with bulge, which is close to a gaussian shape with most stars close to
+/// the center. Radius of the galaxy is comprised in range [4e-5, 140] kly
+inline double radius(double dist) { return 40. * std::sqrt(std::max(1e-12, -std::log(dist))); }
+
+/// Maximal absolute height in kly: diameter ~ 100x thickness, [-1, 1] kly at center, [-0.1, 0.1] kly far away
+inline double maxHeight(double dist) { return 0.9 * std::pow(std::min(1., dist), 3.) + 0.1; }
+
+/// Inverses of the above, not clamped
+inline double rawRadiusAt(double dist) { return (1.000005 - dist) * identifierMax; }
+inline double rawRadius(double radius) { return rawRadiusAt(std::exp(-std::pow(radius / 40., 2.))); }
+/// Edge distance below which heights stay within (-height, height), for height in [0.1, 1]
+inline double edgeDistanceAt(double height) { return std::cbrt((height - 0.1) / 0.9); }
+
+} // namespace detail
+} // namespace system
+} // namespace galaxias
@@ -0,0 +1,219 @@
+#include <system/generator.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+
+namespace galaxias
+{
+namespace system
+{
+
+IdentifierSet::IdentifierSet(uint64_t first, uint64_t last)
+    : first_{first}
+    , last_{last}
+    , size_{last - first}
+{
+    if (first_ > last_ || last_ > SystemIdentifier::valueCount)
+    {
+        throw std::out_of_range("Bad identifier range [" + std::to_string(first_) + ", " + std::to_string(last_) +
+                                ")");
+    }
+}
+
+IdentifierSet::IdentifierSet(std::vector<uint64_t> values)
+    : first_{0}
+    , last_{0}
+    , size_{values.size()}
+    , values_{std::move(values)}
+{
+    for (uint64_t value : values_)
+    {
+        if (value >= SystemIdentifier::valueCount)
+        {
+            throw std::out_of_range("Bad identifier " + std::to_string(value));
+        }
+    }
+}
+
+IdentifierSet::IdentifierSet(std::vector<IdentifierRectangle> rectangles)
+    : first_{0}
+    , last_{0}
+    , size_{0}
+{
+    for (const auto& rectangle : rectangles)
+    {
+        if (rectangle.angleFirst > rectangle.angleLast || rectangle.angleLast > SystemIdentifier::coordinateCount ||
+            rectangle.radiusFirst > rectangle.radiusLast || rectangle.radiusLast > SystemIdentifier::coordinateCount)
+        {
+            throw std::out_of_range("Bad identifier rectangle");
+        }
+        if (rectangle.size() > 0)
+        {
+            rectangles_.push_back(rectangle);
+            offsets_.push_back(size_);
+            size_ += rectangle.size();
+        }
+    }
+}
+
+uint64_t IdentifierSet::inRectangles(size_t i) const
+{
+    const size_t r = std::upper_bound(offsets_.begin(), offsets_.end(), i) - offsets_.begin() - 1;
+    return rectangles_[r][i - offsets_[r]];
+}
+
+////////////////////////////////////////////////////////////////
+
+GalaxyGenerator::GalaxyGenerator(ThreadPool& pool, size_t batchSize)
+    : pool_{pool}
+    , batchSize_{std::max<size_t>(1, batchSize)}
+{
+}
+
+template <class T>
+GenerationStatistics GalaxyGenerator::run(const IdentifierSet& identifiers,
+                                          const std::function<T(std::unique_ptr<ISystem>)>& make,
+                                          const std::function<void(std::span<const T>)>& sink) const
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    // Generate a window of batches at a time, enough to keep every thread busy. Windows are double-buffered: the next
+    // one is generated in the background while the batches of the current one go to the sink, in order
+    const size_t batches = (identifiers.size() + batchSize_ - 1) / batchSize_;
+    const size_t window = 4 * (pool_.threads() + 1);
+    std::array<std::vector<std::vector<T>>, 2> results{std::vector<std::vector<T>>(window),
+                                                       std::vector<std::vector<T>>(window)};
+    const auto generateWindow = [&](size_t first, std::vector<std::vector<T>>& windowResults)
+    {
+        pool_.run(std::min(window, batches - first),
+                  [&](size_t b)
+                  {
+                      const size_t begin = (first + b) * batchSize_;
+                      const size_t end = std::min(identifiers.size(), begin + batchSize_);
+                      auto& batch = windowResults[b];
+                      batch.clear();
+                      batch.reserve(end - begin);
+                      for (size_t i = begin; i < end; ++i)
+                      {
+                          batch.push_back(make(ISystem::create(SystemIdentifier::fromValue(identifiers[i]))));
+                      }
+                  });
+    };
+
+    if (batches > 0)
+    {
+        generateWindow(0, results[0]);
+    }
+    std::future<void> next;
+    for (size_t first = 0, w = 0; first < batches; first += window, ++w)
+    {
+        if (first + window < batches)
+        {
+            next = std::async(std::launch::async, generateWindow, first + window, std::ref(results[(w + 1) % 2]));
+        }
+        const size_t count = std::min(window, batches - first);
+        for (size_t b = 0; b < count; ++b)
+        {
+            sink(results[w % 2][b]);
+        }
+        // Rethrows generation errors. If the sink throws, the future waits for the window in flight when destroyed
+        if (next.valid())
+        {
+            next.get();
+        }
+    }
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return {identifiers.size(), elapsed.count()};
+}
+
+GenerationStatistics GalaxyGenerator::generate(const IdentifierSet& identifiers, const SystemSink& sink) const
+{
+    return run<SystemSummary>(
+        identifiers, [](std::unique_ptr<ISystem> system) { return system->summary(); }, sink);
+}
+
+GenerationStatistics GalaxyGenerator::generateSystems(const IdentifierSet& identifiers,
+                                                      const FullSystemSink& sink) const
+{
+    return run<std::shared_ptr<const ISystem>>(
+        identifiers,
+        [](std::unique_ptr<ISystem> system)
+        {
+            // Properties are generated on first access, do it on the pool
+            system->name();
+            system->stars();
+            return std::shared_ptr<const ISystem>{std::move(system)};
+        },
+        sink);
+}
+
+////////////////////////////////////////////////////////////////
+
+SummaryFileSink::SummaryFileSink(const std::filesystem::path& path)
+    : ofs_{path, std::ios::binary}
+    , written_{0}
+{
+    if (!ofs_)
+    {
+        throw std::runtime_error("Cannot open " + path.string());
+    }
+}
+
+void SummaryFileSink::operator()(std::span<const SystemSummary> summaries)
+{
+    ofs_.write(reinterpret_cast<const char*>(summaries.data()), summaries.size_bytes());
+    if (!ofs_)
+    {
+        throw std::runtime_error("Cannot write systems");
+    }
+    written_ += summaries.size();
+}
+
+////////////////////////////////////////////////////////////////
+
+SummaryQueue::SummaryQueue(size_t capacity)
+    : capacity_{std::max<size_t>(1, capacity)}
+    , closed_{false}
+{
+}
+
+void SummaryQueue::operator()(std::span<const SystemSummary> summaries)
+{
+    std::unique_lock lock{mutex_};
+    changed_.wait(lock, [this]() { return batches_.size() < capacity_ || closed_; });
+    if (closed_)
+    {
+        throw std::runtime_error("Queue is closed");
+    }
+    batches_.emplace_back(summaries.begin(), summaries.end());
+    changed_.notify_all();
+}
+
+std::optional<std::vector<SystemSummary>> SummaryQueue::pop()
+{
+    std::unique_lock lock{mutex_};
+    changed_.wait(lock, [this]() { return !batches_.empty() || closed_; });
+    if (batches_.empty())
+    {
+        return std::nullopt;
+    }
+    auto batch = std::move(batches_.front());
+    batches_.pop_front();
+    changed_.notify_all();
+    return batch;
+}
+
+void SummaryQueue::close()
+{
+    std::lock_guard lock{mutex_};
+    closed_ = true;
+    changed_.notify_all();
+}
+
+} // namespace system
+} // namespace galaxias
@@ -49,6 +49,7 @@ public:
 
 using BolometricMagnitude = qty::Quantity<double, detail::Magnitude>;
 using ApparentMagnitude = qty::Quantity<double, detail::Magnitude>;
+using BandMagnitude = qty::Quantity<double, detail::Magnitude>;
 
 } // namespace system
 } // namespace galaxias
@@ -0,0 +1,157 @@
+#include <system/region.h>
+
+#include "galaxy_shape.h"
+#include "quantity/galactic.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace galaxias
+{
+namespace system
+{
+
+namespace
+{
+
+constexpr int64_t rawCount{int64_t{1} << detail::identifierShift};
+constexpr double fullTurn{2. * std::numbers::pi};
+
+/// Bring an angle in [0, 2 pi)
+double normaliseAngle(double angle)
+{
+    const double result = std::fmod(angle, fullTurn);
+    return result < 0. ? result + fullTurn : result;
+}
+
+} // namespace
+
+GalacticPosition GalacticPosition::of(const SystemSummary& summary)
+{
+    return {summary.radius * std::cos(summary.angle), summary.radius * std::sin(summary.angle), summary.height};
+}
+
+float GalacticPosition::distanceSquared(const GalacticPosition& other) const
+{
+    const float dx = x - other.x;
+    const float dy = y - other.y;
+    const float dz = z - other.z;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+////////////////////////////////////////////////////////////////
+
+GalacticSector GalacticSector::bounding(const GalacticPosition& low, const GalacticPosition& high)
+{
+    GalacticSector sector;
+    sector.heightLow = low.z;
+    sector.heightHigh = high.z;
+
+    const double corners[4][2] = {{low.x, low.y}, {high.x, low.y}, {low.x, high.y}, {high.x, high.y}};
+    const double nearX = std::clamp(0., static_cast<double>(low.x), static_cast<double>(high.x));
+    const double nearY = std::clamp(0., static_cast<double>(low.y), static_cast<double>(high.y));
+    sector.radiusLow = std::hypot(nearX, nearY);
+    sector.radiusHigh = 0.;
+    for (const auto& corner : corners)
+    {
+        sector.radiusHigh = std::max(sector.radiusHigh, std::hypot(corner[0], corner[1]));
+    }
+
+    // Around the centre, every angle is needed. Otherwise the box is seen under less than pi from the centre
+    if (sector.radiusLow == 0.)
+    {
+        return sector;
+    }
+    const double centre = std::atan2(0.5 * (low.y + high.y), 0.5 * (low.x + high.x));
+    double lowDelta = 0.;
+    double highDelta = 0.;
+    for (const auto& corner : corners)
+    {
+        const double delta = std::remainder(std::atan2(corner[1], corner[0]) - centre, fullTurn);
+        lowDelta = std::min(lowDelta, delta);
+        highDelta = std::max(highDelta, delta);
+    }
+    sector.angleLow = normaliseAngle(centre + lowDelta);
+    sector.angleHigh = normaliseAngle(centre + highDelta);
+    return sector;
+}
+
+bool GalacticSector::contains(const orbit::coordinates::GalactoCentric& coordinates) const
+{
+    const double angle = coordinates.angle().value();
+    const double radius = coordinates.radius().value() / KiloLightYear::factor;
+    const double height = coordinates.height().value() / KiloLightYear::factor;
+    const bool inAngles = angleLow <= angleHigh ? angle >= angleLow && angle <= angleHigh
+                                                : angle >= angleLow || angle <= angleHigh;
+    return inAngles && radius >= radiusLow && radius <= radiusHigh && height >= heightLow && height <= heightHigh;
+}
+
+////////////////////////////////////////////////////////////////
+
+uint64_t IdentifierRectangle::operator[](uint64_t i) const
+{
+    const uint64_t width = angleLast - angleFirst;
+    return (static_cast<uint64_t>(radiusFirst + i / width) << detail::identifierShift) | (angleFirst + i % width);
+}
+
+std::vector<IdentifierRectangle> candidateIdentifiers(const GalacticSector& sector)
+{
+    // Coordinates are monotonic in raw coordinates plus a jitter in [0, 1): the raw value of a coordinate is the floor
+    // of its inverse. Ranges are widened by one on each side against rounding errors
+    if (sector.radiusLow > sector.radiusHigh || sector.heightLow > sector.heightHigh)
+    {
+        return {};
+    }
+    const auto floorRaw = [](double raw)
+    { return static_cast<int64_t>(std::clamp(std::floor(raw), -1., static_cast<double>(rawCount))); };
+    const int64_t radiusFirst = std::max<int64_t>(0, floorRaw(detail::rawRadius(std::max(0., sector.radiusLow))) - 1);
+    int64_t radiusLast = std::min(rawCount - 1, floorRaw(detail::rawRadius(std::max(0., sector.radiusHigh))) + 1);
+
+    // Heights are bounded by a decreasing function of the radius, which gives a maximal raw radius
+    const bool aroundPlane = sector.heightLow <= 0. && sector.heightHigh >= 0.;
+    const double height = aroundPlane ? 0. : std::min(std::abs(sector.heightLow), std::abs(sector.heightHigh));
+    if (height > detail::maxHeight(1.))
+    {
+        return {};
+    }
+    if (height > detail::maxHeight(0.))
+    {
+        radiusLast = std::min(radiusLast, floorRaw(detail::rawRadiusAt(detail::edgeDistanceAt(height))) + 1);
+    }
+    if (radiusFirst > radiusLast)
+    {
+        return {};
+    }
+    const auto rectangle = [&](int64_t angleFirst, int64_t angleLast)
+    {
+        return IdentifierRectangle{static_cast<uint32_t>(angleFirst),
+                                   static_cast<uint32_t>(angleLast),
+                                   static_cast<uint32_t>(radiusFirst),
+                                   static_cast<uint32_t>(radiusLast + 1)};
+    };
+
+    // Angles, as an inclusive raw range possibly going past a full turn
+    const double scale = detail::identifierMax / fullTurn;
+    const double angleLow = normaliseAngle(sector.angleLow);
+    const double span =
+        sector.angleHigh - sector.angleLow >= fullTurn ? fullTurn : normaliseAngle(sector.angleHigh - sector.angleLow);
+    int64_t angleFirst = static_cast<int64_t>(std::floor(angleLow * scale)) - 1;
+    int64_t angleLast = static_cast<int64_t>(std::floor((angleLow + span) * scale)) + 1;
+    if (angleLast - angleFirst + 1 >= rawCount)
+    {
+        return {rectangle(0, rawCount)};
+    }
+    if (angleFirst < 0)
+    {
+        angleFirst += rawCount;
+        angleLast += rawCount;
+    }
+    if (angleLast < rawCount)
+    {
+        return {rectangle(angleFirst, angleLast + 1)};
+    }
+    return {rectangle(angleFirst, rawCount), rectangle(0, angleLast - rawCount + 1)};
+}
+
+} // namespace system
+} // namespace galaxias
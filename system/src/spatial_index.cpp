@@ -0,0 +1,224 @@
+#include <system/spatial_index.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace galaxias
+{
+namespace system
+{
+
+namespace
+{
+
+/// Cells per axis are 2^21 so that a Morton code fits 63 bits, centred on the galactic centre
+constexpr uint32_t levels{21};
+constexpr int64_t cellOffset{int64_t{1} << (levels - 1)};
+
+/// Spread the lower 21 bits of a value to every third bit
+uint64_t spread(uint32_t value)
+{
+    uint64_t x = value & 0x1FFFFF;
+    x = (x | x << 32) & 0x1F00000000FFFFULL;
+    x = (x | x << 16) & 0x1F0000FF0000FFULL;
+    x = (x | x << 8) & 0x100F00F00F00F00FULL;
+    x = (x | x << 4) & 0x10C30C30C30C30C3ULL;
+    x = (x | x << 2) & 0x1249249249249249ULL;
+    return x;
+}
+
+uint64_t morton(uint32_t x, uint32_t y, uint32_t z) { return spread(x) | spread(y) << 1 | spread(z) << 2; }
+
+} // namespace
+
+SpatialIndex::SpatialIndex(float cellSize)
+    : cellSize_{cellSize}
+    , size_{0}
+{
+    if (!(cellSize_ > 0.f))
+    {
+        throw std::runtime_error("Spatial index needs a positive cell size");
+    }
+}
+
+uint64_t SpatialIndex::cellCode(const GalacticPosition& position) const
+{
+    uint32_t cell[3];
+    const float coords[3] = {position.x, position.y, position.z};
+    for (size_t i = 0; i < 3; ++i)
+    {
+        const int64_t c = static_cast<int64_t>(std::floor(coords[i] / cellSize_)) + cellOffset;
+        if (!std::isfinite(coords[i]) || c < 0 || c >= 2 * cellOffset)
+        {
+            throw std::out_of_range("Position out of the index: " + std::to_string(coords[i]) + " kly");
+        }
+        cell[i] = static_cast<uint32_t>(c);
+    }
+    return morton(cell[0], cell[1], cell[2]);
+}
+
+void SpatialIndex::insert(uint64_t identifier, const GalacticPosition& position)
+{
+    cells_[cellCode(position)].push_back({identifier, position});
+    ++size_;
+}
+
+void SpatialIndex::insert(std::span<const SystemSummary> summaries)
+{
+    for (const auto& summary : summaries)
+    {
+        insert(summary.identifier, GalacticPosition::of(summary));
+    }
+}
+
+std::vector<SpatialIndex::Entry> SpatialIndex::withinRadius(const GalacticPosition& centre, float radius) const
+{
+    const float radius2 = radius * radius;
+    const auto classify = [&](const Box& box)
+    {
+        // Squared distances to the nearest and farthest points of the box
+        float near = 0.f;
+        float far = 0.f;
+        const float c[3] = {centre.x, centre.y, centre.z};
+        const float low[3] = {box.low.x, box.low.y, box.low.z};
+        const float high[3] = {box.high.x, box.high.y, box.high.z};
+        for (size_t i = 0; i < 3; ++i)
+        {
+            const float d = std::max({low[i] - c[i], 0.f, c[i] - high[i]});
+            const float f = std::max(c[i] - low[i], high[i] - c[i]);
+            near += d * d;
+            far += f * f;
+        }
+        return near > radius2 ? Overlap::Outside : far <= radius2 ? Overlap::Inside : Overlap::Partial;
+    };
+    const auto contains = [&](const GalacticPosition& position) { return position.distanceSquared(centre) <= radius2; };
+
+    std::vector<Entry> result;
+    query(classify, contains, result);
+    return result;
+}
+
+std::vector<SpatialIndex::Entry> SpatialIndex::nearest(const GalacticPosition& centre, size_t count) const
+{
+    // Grow a sphere until it holds enough entries: all the closest ones are then inside
+    std::vector<Entry> result;
+    for (float radius = cellSize_; count > 0 && size_ > 0; radius *= 2.f)
+    {
+        result = withinRadius(centre, radius);
+        if (result.size() >= count || result.size() == size_)
+        {
+            break;
+        }
+    }
+    const size_t kept = std::min(count, result.size());
+    std::partial_sort(result.begin(),
+                      result.begin() + kept,
+                      result.end(),
+                      [&](const Entry& a, const Entry& b)
+                      { return a.position.distanceSquared(centre) < b.position.distanceSquared(centre); });
+    result.resize(kept);
+    return result;
+}
+
+std::vector<SpatialIndex::Entry> SpatialIndex::inside(std::span<const Plane> planes) const
+{
+    const auto classify = [&](const Box& box)
+    {
+        Overlap overlap = Overlap::Inside;
+        for (const auto& p : planes)
+        {
+            // Corners of the box farthest along and against the normal
+            const float farthest = p.a * (p.a > 0.f ? box.high.x : box.low.x) +
+                                   p.b * (p.b > 0.f ? box.high.y : box.low.y) +
+                                   p.c * (p.c > 0.f ? box.high.z : box.low.z) + p.d;
+            const float nearest = p.a * (p.a > 0.f ? box.low.x : box.high.x) +
+                                  p.b * (p.b > 0.f ? box.low.y : box.high.y) +
+                                  p.c * (p.c > 0.f ? box.low.z : box.high.z) + p.d;
+            if (farthest < 0.f)
+            {
+                return Overlap::Outside;
+            }
+            if (nearest < 0.f)
+            {
+                overlap = Overlap::Partial;
+            }
+        }
+        return overlap;
+    };
+    const auto contains = [&](const GalacticPosition& position)
+    {
+        return std::all_of(planes.begin(),
+                           planes.end(),
+                           [&](const Plane& p)
+                           { return p.a * position.x + p.b * position.y + p.c * position.z + p.d >= 0.f; });
+    };
+
+    std::vector<Entry> result;
+    query(classify, contains, result);
+    return result;
+}
+
+void SpatialIndex::query(const Classify& classify, const Contains& contains, std::vector<Entry>& result) const
+{
+    descend(levels, 0, 0, 0, classify, contains, result);
+}
+
+void SpatialIndex::descend(uint32_t level,
+                           uint32_t x,
+                           uint32_t y,
+                           uint32_t z,
+                           const Classify& classify,
+                           const Contains& contains,
+                           std::vector<Entry>& result) const
+{
+    // Cells of the node are the codes [first, last)
+    const uint64_t first = morton(x, y, z) << (3 * level);
+    const uint64_t last = first + (uint64_t{1} << (3 * level));
+    auto it = cells_.lower_bound(first);
+    if (it == cells_.end() || it->first >= last)
+    {
+        return;
+    }
+
+    const float side = cellSize_ * static_cast<float>(uint64_t{1} << level);
+    const auto corner = [&](uint32_t c) { return static_cast<float>(static_cast<int64_t>(c << level) - cellOffset); };
+    const GalacticPosition low{corner(x) * cellSize_, corner(y) * cellSize_, corner(z) * cellSize_};
+    const Overlap overlap = classify({low, {low.x + side, low.y + side, low.z + side}});
+    if (overlap == Overlap::Outside)
+    {
+        return;
+    }
+
+    // Test entries one by one at the bottom, or as soon as a single cell is left
+    const auto next = std::next(it);
+    if (overlap == Overlap::Inside || level == 0 || next == cells_.end() || next->first >= last)
+    {
+        for (; it != cells_.end() && it->first < last; ++it)
+        {
+            for (const auto& entry : it->second)
+            {
+                if (overlap == Overlap::Inside || contains(entry.position))
+                {
+                    result.push_back(entry);
+                }
+            }
+        }
+        return;
+    }
+
+    for (uint32_t child = 0; child < 8; ++child)
+    {
+        descend(level - 1,
+                2 * x + (child & 1),
+                2 * y + (child >> 1 & 1),
+                2 * z + (child >> 2 & 1),
+                classify,
+                contains,
+                result);
+    }
+}
+
+} // namespace system
+} // namespace galaxias
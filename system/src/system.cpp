@@ -6,7 +6,9 @@
 #include <math/rng/fixed_proba.h>
 #include <math/rng/prng.h>
 
+#include <algorithm>
 #include <cassert>
+#include <mutex>
 
 namespace galaxias
 {
@@ -40,56 +42,143 @@ std::string generateName(Rng&& dice)
 
 } // namespace
 
+/// Properties are generated on first access, so that e.g. browsing the map only pays for coordinates.
+/// Each property draws from its own copy of the identifier dice: the result does not depend on the order of access
 class System : public ISystem
 {
 public:
     System(SystemIdentifier&& identifier);
     virtual ~System() {}
 
-    void initialise();
-
     const orbit::coordinates::GalactoCentric& galacticCoords() const override { return identifier_.coordinates(); }
+    const std::string& name() const override;
+    size_t starsCount() const override;
+    std::vector<StarSummary> stars() const override;
+    SystemSummary summary() const override;
+    size_t memoryUsage() const override;
+
+private:
+    const std::vector<std::shared_ptr<Star>>& generatedStars() const;
+    /// Dice of the stars, positioned before the draw of their number
+    Rng starsDice() const;
+    static size_t drawStarsCount(Rng& dice);
 
 private:
     SystemIdentifier identifier_;
-    const std::string name_;
+
+    mutable std::once_flag nameFlag_;
+    mutable std::string name_;
+    mutable std::once_flag starsCountFlag_;
+    mutable size_t starsCount_;
+    mutable std::once_flag starsFlag_;
+    mutable std::vector<std::shared_ptr<Star>> stars_;
 };
 
 System::System(SystemIdentifier&& identifier)
     : identifier_{std::move(identifier)}
-    , name_{generateName(Rng{identifier_.dice()})}
+    , starsCount_{0}
 {
 }
 
-void System::initialise()
+const std::string& System::name() const
 {
-    // Determine number of stars
-    Rng systemDice(identifier_.dice());
-    const size_t starsCount =
-        1 + systemDice.realisation(math::rng::FixThenHalve<float>({0.321, 0.479, 0.114, 0.044, 0.022, 0.010}),
-                                   math::rng::FixThenHalve<float>());
-
-    // Determine stars characteristics
-    std::vector<std::shared_ptr<IBody>> bodies;
-    for (size_t i = 0; i < starsCount; ++i)
+    std::call_once(nameFlag_,
+                   [this]()
+                   {
+                       Rng dice{identifier_.dice()};
+                       name_ = generateName(Rng{dice});
+                   });
+    return name_;
+}
+
+size_t System::starsCount() const
+{
+    std::call_once(starsCountFlag_,
+                   [this]()
+                   {
+                       auto dice = starsDice();
+                       starsCount_ = drawStarsCount(dice);
+                   });
+    return starsCount_;
+}
+
+std::vector<StarSummary> System::stars() const
+{
+    std::vector<StarSummary> result;
+    for (const auto& star : generatedStars())
     {
-        bodies.emplace_back(std::make_shared<Star>(Rng{systemDice}));
+        result.push_back({static_cast<float>(star->mass().value() / SolarMass::factor),
+                          static_cast<float>(star->radius().value()),
+                          static_cast<float>(star->temperature().value()),
+                          static_cast<float>(star->luminosity().value())});
     }
+    return result;
+}
 
-    // Reorder stars randomly, yielding a hierarchy for the system (A > B => B orbits A, A < B => B is new attractor)
+const std::vector<std::shared_ptr<Star>>& System::generatedStars() const
+{
+    std::call_once(starsFlag_,
+                   [this]()
+                   {
+                       // Determine number of stars
+                       auto systemDice = starsDice();
+                       const size_t count = drawStarsCount(systemDice);
+
+                       // Determine stars characteristics
+                       for (size_t i = 0; i < count; ++i)
+                       {
+                           stars_.emplace_back(std::make_shared<Star>(Rng{systemDice}));
+                       }
+
+                       // Reorder stars randomly, yielding a hierarchy for the system
+                       // (A > B => B orbits A, A < B => B is new attractor)
+
+                       // Determine planets characteristics, on first access as well
+
+                       // Create hierarchy by grouping by weight of stars only (in-order) ??? Log distance ? SOI ?
+                   });
+    return stars_;
+}
+
+Rng System::starsDice() const
+{
+    // The name is drawn first from the identifier dice, then the stars
+    Rng dice{identifier_.dice()};
+    dice.uniform();
+    return Rng{dice};
+}
 
-    // Determine planets characteristics
+size_t System::drawStarsCount(Rng& dice)
+{
+    return 1 + dice.realisation(math::rng::FixThenHalve<float>({0.321, 0.479, 0.114, 0.044, 0.022, 0.010}),
+                                math::rng::FixThenHalve<float>());
+}
 
-    // Add planets
+SystemSummary System::summary() const
+{
+    const auto& coords = identifier_.coordinates();
+    const auto& stars = generatedStars();
+    const auto primary = std::max_element(
+        stars.begin(), stars.end(), [](const auto& a, const auto& b) { return a->mass() < b->mass(); });
+    return {identifier_.asValue(),
+            static_cast<float>(coords.angle().value()),
+            static_cast<float>(coords.radius().value() / KiloLightYear::factor),
+            static_cast<float>(coords.height().value() / KiloLightYear::factor),
+            static_cast<uint32_t>(stars.size()),
+            static_cast<float>((*primary)->mass().value() / SolarMass::factor),
+            static_cast<float>((*primary)->temperature().value())};
+}
 
-    // Create hierarchy by grouping by weight of stars only (in-order) ??? Log distance ? Mind the SOI ?
+size_t System::memoryUsage() const
+{
+    // Names fit in the small string buffer; each star also has its control block
+    constexpr size_t controlBlock{2 * sizeof(void*)};
+    return sizeof(System) + starsCount() * (sizeof(std::shared_ptr<Star>) + sizeof(Star) + controlBlock);
 }
 
 std::unique_ptr<ISystem> ISystem::create(SystemIdentifier&& identifier)
 {
-    auto system = std::make_unique<System>(std::move(identifier));
-    system->initialise();
-    return system;
+    return std::make_unique<System>(std::move(identifier));
 }
 
 } // namespace system
@@ -0,0 +1,197 @@
+#include <system/system_cache.h>
+
+#include <algorithm>
+#include <tuple>
+
+namespace galaxias
+{
+namespace system
+{
+
+SystemCache::SystemCache(size_t maxBytes, size_t shards)
+    : maxBytes_{maxBytes}
+    , bytes_{0}
+    , nextTrim_{0}
+{
+    for (size_t i = 0; i < std::max<size_t>(1, shards); ++i)
+    {
+        shards_.push_back(std::make_unique<Shard>());
+    }
+}
+
+SystemCache::Shard& SystemCache::shardOf(uint64_t value) const
+{
+    // Neighbour identifiers differ in their lowest bits only, mix them in the upper ones
+    return *shards_[((value * 0x9E3779B97F4A7C15ULL) >> 32) % shards_.size()];
+}
+
+SystemCache::Entry& SystemCache::find(Shard& shard, std::unique_lock<std::mutex>& lock, uint64_t value)
+{
+    auto it = shard.entries.find(value);
+    if (it != shard.entries.end())
+    {
+        ++shard.hits;
+        if (it->second.pins == 0)
+        {
+            shard.uses.splice(shard.uses.begin(), shard.uses, it->second.use);
+        }
+        return it->second;
+    }
+    ++shard.misses;
+
+    // Generate without holding the lock. Another thread may insert the same system meanwhile, then keep the first one
+    lock.unlock();
+    std::shared_ptr<const ISystem> system = ISystem::create(SystemIdentifier::fromValue(value));
+    const size_t bytes = system->memoryUsage();
+    lock.lock();
+
+    bool inserted;
+    std::tie(it, inserted) = shard.entries.try_emplace(value, Entry{std::move(system), bytes, 0, {}});
+    if (inserted)
+    {
+        shard.uses.push_front(value);
+        it->second.use = shard.uses.begin();
+        shard.bytes += bytes;
+        bytes_ += bytes;
+    }
+    else if (it->second.pins == 0)
+    {
+        shard.uses.splice(shard.uses.begin(), shard.uses, it->second.use);
+    }
+    return it->second;
+}
+
+void SystemCache::evict(Shard& shard)
+{
+    while (bytes_ > maxBytes_ && !shard.uses.empty())
+    {
+        const auto it = shard.entries.find(shard.uses.back());
+        shard.bytes -= it->second.bytes;
+        bytes_ -= it->second.bytes;
+        shard.entries.erase(it);
+        shard.uses.pop_back();
+        ++shard.evictions;
+    }
+}
+
+void SystemCache::trim()
+{
+    const size_t first = nextTrim_++;
+    for (size_t i = 0; i < shards_.size() && bytes_ > maxBytes_; ++i)
+    {
+        auto& shard = *shards_[(first + i) % shards_.size()];
+        std::lock_guard lock{shard.mutex};
+        evict(shard);
+    }
+}
+
+std::shared_ptr<const ISystem> SystemCache::get(uint64_t value)
+{
+    std::shared_ptr<const ISystem> system;
+    {
+        auto& shard = shardOf(value);
+        std::unique_lock lock{shard.mutex};
+        system = find(shard, lock, value).system;
+        evict(shard);
+    }
+    trim();
+    return system;
+}
+
+bool SystemCache::contains(uint64_t value) const
+{
+    const auto& shard = shardOf(value);
+    std::lock_guard lock{shard.mutex};
+    return shard.entries.contains(value);
+}
+
+void SystemCache::pin(std::span<const uint64_t> values)
+{
+    for (uint64_t value : values)
+    {
+        auto& shard = shardOf(value);
+        std::unique_lock lock{shard.mutex};
+        auto& entry = find(shard, lock, value);
+        if (entry.pins++ == 0)
+        {
+            shard.uses.erase(entry.use);
+        }
+        evict(shard);
+    }
+    trim();
+}
+
+void SystemCache::unpin(std::span<const uint64_t> values)
+{
+    for (uint64_t value : values)
+    {
+        auto& shard = shardOf(value);
+        std::lock_guard lock{shard.mutex};
+        const auto it = shard.entries.find(value);
+        if (it == shard.entries.end() || it->second.pins == 0)
+        {
+            continue;
+        }
+        if (--it->second.pins == 0)
+        {
+            shard.uses.push_front(value);
+            it->second.use = shard.uses.begin();
+            evict(shard);
+        }
+    }
+    trim();
+}
+
+void SystemCache::unpinAll()
+{
+    for (auto& shard : shards_)
+    {
+        std::lock_guard lock{shard->mutex};
+        for (auto& [value, entry] : shard->entries)
+        {
+            if (entry.pins > 0)
+            {
+                entry.pins = 0;
+                shard->uses.push_front(value);
+                entry.use = shard->uses.begin();
+            }
+        }
+        evict(*shard);
+    }
+    trim();
+}
+
+void SystemCache::clear()
+{
+    for (auto& shard : shards_)
+    {
+        std::lock_guard lock{shard->mutex};
+        for (uint64_t value : shard->uses)
+        {
+            const auto it = shard->entries.find(value);
+            shard->bytes -= it->second.bytes;
+            bytes_ -= it->second.bytes;
+            shard->entries.erase(it);
+        }
+        shard->uses.clear();
+    }
+}
+
+SystemCache::Statistics SystemCache::statistics() const
+{
+    Statistics statistics{};
+    for (const auto& shard : shards_)
+    {
+        std::lock_guard lock{shard->mutex};
+        statistics.hits += shard->hits;
+        statistics.misses += shard->misses;
+        statistics.evictions += shard->evictions;
+        statistics.systems += shard->entries.size();
+        statistics.pinned += shard->entries.size() - shard->uses.size();
+        statistics.bytes += shard->bytes;
+    }
+    return statistics;
+}
+
+} // namespace system
+} // namespace galaxias
@@ -1,5 +1,6 @@
 #include <system/system_identifier.h>
 
+#include "galaxy_shape.h"
 #include "quantity/galactic.h"
 #include <math/bounded_quantity.h>
 
@@ -11,6 +12,8 @@ namespace qty = math::quantity;
 namespace system
 {
 
+using namespace detail;
+
 namespace
 {
 
@@ -18,10 +21,8 @@ constexpr math::Range<double> range01 = math::Range<double>::zeroOne();
 constexpr math::Range<double> rangePM1{-1., 1.};
 constexpr auto rangeRadian{math::Range<double>::radians()};
 
-constexpr uint64_t identifierShift{18};
-constexpr uint32_t identifierMask = 0x3FFFF;
 constexpr uint64_t coordsMask{0x2378A9CB3FEC95CULL};
-constexpr double identifierMax = 262144.; // 0x40000 as integer
+constexpr uint64_t propertyMask{0x5D1B7A04C39E6F28ULL};
 
 math::rng::Random makeSystemDice(uint64_t r, uint64_t phi)
 {
@@ -43,12 +44,10 @@ orbit::coordinates::GalactoCentric makeCoordinates(math::rng::Random& dice, uint
     const auto angle = qty::BoundedRadian::fromModulo(
         rangeRadian.high() * (static_cast<double>(rawAngle) + coordsDice.uniform(range01)) / identifierMax,
         rangeRadian);
-    // We simulate a spiral galaxy with bulge, which is close to a guassian shape with most stars close to center
-    const double dist = 1.000005 - (static_cast<double>(rawRadius) + coordsDice.uniform(range01)) / identifierMax;
-    // -> Radius of the galaxy is comprised in range [4e-5, 140] kly
-    const KiloLightYear galactic_radius{40. * std::sqrt(std::max(1e-12, -std::log(dist)))};
-    // -> Height depends on distance with diameter ~ 100x thickness: [-1, 1] kly at center, [-0.1, 0.1] kly far away
-    const KiloLightYear galactic_height{coordsDice.uniform(rangePM1) * (0.9 * std::pow(std::min(1., dist), 3.) + 0.1)};
+    // Radius and height follow the shape of the galaxy, see galaxy_shape.h
+    const double dist = edgeDistance(static_cast<double>(rawRadius) + coordsDice.uniform(range01));
+    const KiloLightYear galactic_radius{radius(dist)};
+    const KiloLightYear galactic_height{coordsDice.uniform(rangePM1) * maxHeight(dist)};
 
     return {angle, galactic_radius.base(), galactic_height.base()};
 }
@@ -83,6 +82,13 @@ uint64_t SystemIdentifier::asValue() const
     return (static_cast<uint64_t>(radius_) << identifierShift) | static_cast<uint64_t>(angle_);
 }
 
+math::rng::Keyed SystemIdentifier::dice(Property property, uint32_t index) const
+{
+    // Stream is (property, index) so that e.g. each star of a system can be drawn without drawing the previous ones
+    const uint64_t stream = (static_cast<uint64_t>(property) << 32) | static_cast<uint64_t>(index);
+    return math::rng::Keyed{math::rng::detail::SplitMixCounter{asValue() ^ propertyMask, stream}};
+}
+
 const orbit::coordinates::GalactoCentric& SystemIdentifier::coordinates() const { return coords_; }
 
 } // namespace system
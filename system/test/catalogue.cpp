@@ -0,0 +1,84 @@
+#include <system/catalogue.h>
+
+#include <core/files.h>
+
+#include <catch2/catch.hpp>
+
+#include <fstream>
+
+using namespace galaxias;
+using namespace system;
+
+TEST_CASE("Catalogue round trip")
+{
+    TemporaryFolder folder;
+    const auto path = folder.path() / "galaxy.catalogue";
+
+    // Unordered, in bulk and one by one
+    ThreadPool pool{2};
+    {
+        CatalogueWriter writer{16};
+        writer.add(IdentifierSet{1000, 1500}, GalaxyGenerator{pool, 64});
+        writer.add(*ISystem::create(SystemIdentifier::fromValue(123456789)));
+        writer.add(IdentifierSet{{5, 900, 2}}, GalaxyGenerator{pool});
+        CHECK(writer.size() == 504);
+        writer.write(path);
+
+        writer.add(*ISystem::create(SystemIdentifier::fromValue(2)));
+        CHECK_THROWS_AS(writer.write(folder.path() / "duplicate.catalogue"), std::runtime_error);
+    }
+
+    const Catalogue catalogue{path};
+    REQUIRE(catalogue.size() == 504);
+    const auto systems = catalogue.systems();
+    CHECK(std::is_sorted(systems.begin(),
+                         systems.end(),
+                         [](const auto& a, const auto& b) { return a.identifier < b.identifier; }));
+    for (const auto& record : systems)
+    {
+        const auto system = ISystem::create(SystemIdentifier::fromValue(record.identifier));
+        CHECK(catalogue.summary(record) == system->summary());
+        CHECK(catalogue.name(record) == system->name());
+        const auto stars = catalogue.stars(record);
+        CHECK(std::vector<StarSummary>(stars.begin(), stars.end()) == system->stars());
+    }
+
+    REQUIRE(catalogue.find(123456789));
+    CHECK(catalogue.name(*catalogue.find(123456789)) == "Zotosumexi");
+    CHECK(catalogue.find(1499)->identifier == 1499);
+    CHECK(catalogue.find(2)->identifier == 2);
+    CHECK(catalogue.find(3) == nullptr);
+    CHECK(catalogue.find(1500) == nullptr);
+    CHECK(catalogue.find(SystemIdentifier::valueCount) == nullptr);
+
+    const auto range = catalogue.range(900, 1016);
+    REQUIRE(range.size() == 17);
+    CHECK(range.front().identifier == 900);
+    CHECK(range.back().identifier == 1015);
+    CHECK(catalogue.range(1500, 1600).empty());
+    CHECK(catalogue.range(0, SystemIdentifier::valueCount).size() == catalogue.size());
+}
+
+TEST_CASE("Invalid catalogues")
+{
+    TemporaryFolder folder;
+    const auto path = folder.path() / "empty.catalogue";
+    CatalogueWriter{}.write(path);
+    const Catalogue empty{path};
+    CHECK(empty.size() == 0);
+    CHECK(empty.find(0) == nullptr);
+    CHECK(empty.range(0, 10).empty());
+
+    const auto invalid = folder.path() / "invalid.catalogue";
+    std::ofstream{invalid} << "GXPACK not a catalogue, but long enough to hold a header of 72 bytes.....";
+    CHECK_THROWS_AS(Catalogue{invalid}, std::runtime_error);
+
+    const auto truncated = folder.path() / "truncated.catalogue";
+    {
+        CatalogueWriter writer;
+        writer.add(IdentifierSet{0, 10});
+        writer.write(truncated);
+    }
+    std::filesystem::resize_file(truncated, 200);
+    CHECK_THROWS_AS(Catalogue{truncated}, std::runtime_error);
+}
@@ -0,0 +1,143 @@
+#include <system/generator.h>
+
+#include <core/files.h>
+
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace galaxias;
+using namespace system;
+
+namespace
+{
+
+std::vector<SystemSummary> generateAll(const IdentifierSet& identifiers, size_t threads, size_t batchSize)
+{
+    ThreadPool pool{threads};
+    std::vector<SystemSummary> summaries;
+    GalaxyGenerator{pool, batchSize}.generate(identifiers,
+                                              [&](std::span<const SystemSummary> batch)
+                                              { summaries.insert(summaries.end(), batch.begin(), batch.end()); });
+    return summaries;
+}
+
+} // namespace
+
+TEST_CASE("Identifier sets")
+{
+    const IdentifierSet range{10, 15};
+    CHECK(range.size() == 5);
+    CHECK(range[0] == 10);
+    CHECK(range[4] == 14);
+
+    const IdentifierSet values{{7, 3, 42}};
+    CHECK(values.size() == 3);
+    CHECK(values[2] == 42);
+
+    CHECK(IdentifierSet::all().size() == SystemIdentifier::valueCount);
+    CHECK_THROWS_AS(IdentifierSet(5, 4), std::out_of_range);
+    CHECK_THROWS_AS(IdentifierSet(0, SystemIdentifier::valueCount + 1), std::out_of_range);
+    CHECK_THROWS_AS(IdentifierSet(std::vector<uint64_t>{SystemIdentifier::valueCount}), std::out_of_range);
+}
+
+TEST_CASE("Generated summaries match the systems")
+{
+    const auto summaries = generateAll(IdentifierSet{{2, 123456789}}, 2, 1);
+    REQUIRE(summaries.size() == 2);
+    for (const auto& summary : summaries)
+    {
+        const auto system = ISystem::create(SystemIdentifier::fromValue(summary.identifier));
+        CHECK(summary == system->summary());
+        CHECK(summary.stars == system->starsCount());
+        CHECK(summary.stars >= 1);
+        CHECK(summary.primaryMass > 0.f);
+        CHECK(summary.primaryTemperature > 0.f);
+    }
+    CHECK(summaries[0].identifier == 2);
+    CHECK(summaries[0].angle == Approx(0.0000566644));
+    CHECK(summaries[0].height == Approx(0.8131600274));
+}
+
+TEST_CASE("Generation is independent of the number of threads")
+{
+    const IdentifierSet identifiers{1000, 3000};
+    const auto single = generateAll(identifiers, 1, 100);
+    const auto multiple = generateAll(identifiers, 4, 37);
+    REQUIRE(single.size() == identifiers.size());
+    REQUIRE(multiple.size() == identifiers.size());
+    for (size_t i = 0; i < single.size(); ++i)
+    {
+        CHECK(single[i].identifier == identifiers[i]);
+        CHECK(single[i] == multiple[i]);
+    }
+
+    ThreadPool pool{2};
+    const auto statistics = GalaxyGenerator{pool}.generate(identifiers, [](std::span<const SystemSummary>) {});
+    CHECK(statistics.systems == identifiers.size());
+    CHECK(statistics.systemsPerSecond() > 0.);
+
+    // Sink errors stop the generation, while later windows are being generated
+    size_t delivered = 0;
+    const auto failing = [&](std::span<const SystemSummary> batch)
+    {
+        delivered += batch.size();
+        if (delivered > 500)
+        {
+            throw std::runtime_error("Disk full");
+        }
+    };
+    CHECK_THROWS_AS(GalaxyGenerator(pool, 10).generate(identifiers, failing), std::runtime_error);
+    CHECK(delivered == 510);
+}
+
+TEST_CASE("Generation sinks")
+{
+    const IdentifierSet identifiers{500, 900};
+    const auto expected = generateAll(identifiers, 1, 64);
+    ThreadPool pool{3};
+    GalaxyGenerator generator{pool, 64};
+
+    SECTION("File")
+    {
+        TemporaryFolder folder;
+        const auto path = folder.path() / "systems.bin";
+        {
+            SummaryFileSink sink{path};
+            generator.generate(identifiers, std::ref(sink));
+            CHECK(sink.written() == identifiers.size());
+        }
+        REQUIRE(std::filesystem::file_size(path) == identifiers.size() * sizeof(SystemSummary));
+        std::vector<SystemSummary> read(identifiers.size());
+        std::ifstream ifs{path, std::ios::binary};
+        ifs.read(reinterpret_cast<char*>(read.data()), read.size() * sizeof(SystemSummary));
+        for (size_t i = 0; i < read.size(); ++i)
+        {
+            CHECK(read[i] == expected[i]);
+        }
+    }
+
+    SECTION("Queue")
+    {
+        SummaryQueue queue{2};
+        std::vector<SystemSummary> received;
+        std::thread consumer{[&]()
+                             {
+                                 while (auto batch = queue.pop())
+                                 {
+                                     received.insert(received.end(), batch->begin(), batch->end());
+                                 }
+                             }};
+        generator.generate(identifiers, std::ref(queue));
+        queue.close();
+        consumer.join();
+        REQUIRE(received.size() == expected.size());
+        for (size_t i = 0; i < received.size(); ++i)
+        {
+            CHECK(received[i] == expected[i]);
+        }
+        CHECK_THROWS_AS(queue(expected), std::runtime_error);
+    }
+}
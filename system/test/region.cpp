@@ -0,0 +1,146 @@
+#include <system/generator.h>
+#include <system/region.h>
+
+#include "../src/quantity/galactic.h"
+
+#include <catch2/catch.hpp>
+
+#include <random>
+
+using namespace galaxias;
+using namespace system;
+
+namespace
+{
+
+bool covered(const std::vector<IdentifierRectangle>& rectangles, uint64_t value)
+{
+    const auto identifier = SystemIdentifier::fromValue(value);
+    for (const auto& r : rectangles)
+    {
+        if (identifier.angle() >= r.angleFirst && identifier.angle() < r.angleLast &&
+            identifier.radius() >= r.radiusFirst && identifier.radius() < r.radiusLast)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t size(const std::vector<IdentifierRectangle>& rectangles)
+{
+    uint64_t result = 0;
+    for (const auto& r : rectangles)
+    {
+        result += r.size();
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("Candidate identifiers cover their sector")
+{
+    GalacticSector wedge;
+    wedge.angleLow = 1.;
+    wedge.angleHigh = 1.2;
+    wedge.radiusLow = 10.;
+    wedge.radiusHigh = 20.;
+
+    GalacticSector wrapping;
+    wrapping.angleLow = 6.2;
+    wrapping.angleHigh = 0.1;
+    wrapping.radiusHigh = 5.;
+
+    GalacticSector thick;
+    thick.heightLow = 0.5;
+    thick.heightHigh = 1.;
+
+    std::mt19937_64 engine{7};
+    std::uniform_int_distribution<uint64_t> values{0, SystemIdentifier::valueCount - 1};
+    for (const auto& sector : {wedge, wrapping, thick})
+    {
+        const auto candidates = candidateIdentifiers(sector);
+        REQUIRE(!candidates.empty());
+        CHECK(size(candidates) < SystemIdentifier::valueCount / 4);
+
+        size_t inside = 0;
+        for (size_t i = 0; i < 200000; ++i)
+        {
+            const uint64_t value = values(engine);
+            if (sector.contains(SystemIdentifier::fromValue(value).coordinates()))
+            {
+                ++inside;
+                CHECK(covered(candidates, value));
+            }
+        }
+        CHECK(inside > 50);
+    }
+
+    GalacticSector impossible;
+    impossible.heightLow = 1.5;
+    CHECK(candidateIdentifiers(impossible).empty());
+    CHECK(size(candidateIdentifiers({})) == SystemIdentifier::valueCount);
+}
+
+TEST_CASE("Candidate identifiers of a neighbourhood")
+{
+    for (uint64_t value : {uint64_t{123456789}, uint64_t{2}, SystemIdentifier::valueCount - 1})
+    {
+        // Box of 50 ly around a system
+        const auto& coords = SystemIdentifier::fromValue(value).coordinates();
+        const double radius = coords.radius().value() / KiloLightYear::factor;
+        const double height = coords.height().value() / KiloLightYear::factor;
+        const GalacticPosition centre{static_cast<float>(radius * std::cos(coords.angle().value())),
+                                      static_cast<float>(radius * std::sin(coords.angle().value())),
+                                      static_cast<float>(height)};
+        const GalacticSector sector = GalacticSector::bounding({centre.x - 0.05f, centre.y - 0.05f, centre.z - 0.05f},
+                                                               {centre.x + 0.05f, centre.y + 0.05f, centre.z + 0.05f});
+        CHECK(sector.contains(coords));
+
+        const auto candidates = candidateIdentifiers(sector);
+        CHECK(covered(candidates, value));
+        CHECK(size(candidates) < SystemIdentifier::valueCount / 100);
+    }
+
+    // Around the centre, every angle is a candidate
+    const auto centre = GalacticSector::bounding({-0.1f, -0.1f, -0.1f}, {0.1f, 0.1f, 0.1f});
+    CHECK(centre.radiusLow == 0.);
+    const auto candidates = candidateIdentifiers(centre);
+    REQUIRE(candidates.size() == 1);
+    CHECK(candidates.front().angleFirst == 0);
+    CHECK(candidates.front().angleLast == SystemIdentifier::coordinateCount);
+}
+
+TEST_CASE("Identifier sets of candidates")
+{
+    const std::vector<IdentifierRectangle> rectangles{{10, 13, 2, 4}, {0, 0, 5, 9}, {100, 101, 7, 8}};
+    const IdentifierSet identifiers{rectangles};
+    REQUIRE(identifiers.size() == 7);
+    const uint64_t shift = 18;
+    CHECK(identifiers[0] == (2 << shift | 10));
+    CHECK(identifiers[2] == (2 << shift | 12));
+    CHECK(identifiers[3] == (3 << shift | 10));
+    CHECK(identifiers[5] == (3 << shift | 12));
+    CHECK(identifiers[6] == (7 << shift | 100));
+    CHECK_THROWS_AS(IdentifierSet(std::vector<IdentifierRectangle>{{0, SystemIdentifier::coordinateCount + 1, 0, 1}}),
+                    std::out_of_range);
+
+    // Generating candidates then filtering gives the systems of a sector
+    GalacticSector sector;
+    sector.angleLow = 2.;
+    sector.angleHigh = 2.001;
+    sector.radiusHigh = 0.5;
+    ThreadPool pool{2};
+    size_t inside = 0;
+    GalaxyGenerator{pool}.generate(IdentifierSet::candidates(sector),
+                                   [&](std::span<const SystemSummary> batch)
+                                   {
+                                       for (const auto& summary : batch)
+                                       {
+                                           inside += summary.angle >= 2.f && summary.angle <= 2.001f &&
+                                                     summary.radius <= 0.5f;
+                                       }
+                                   });
+    CHECK(inside > 0);
+}
@@ -0,0 +1,159 @@
+#include <system/generator.h>
+#include <system/spatial_index.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+using namespace galaxias;
+using namespace system;
+
+namespace
+{
+
+std::vector<uint64_t> identifiers(std::vector<SpatialIndex::Entry> entries)
+{
+    std::vector<uint64_t> result;
+    for (const auto& entry : entries)
+    {
+        result.push_back(entry.identifier);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+/// Random positions in a thick disk, indexed by their rank
+std::vector<GalacticPosition> randomPositions(size_t count)
+{
+    std::mt19937_64 engine{42};
+    std::uniform_real_distribution<float> plane{-2.f, 2.f};
+    std::uniform_real_distribution<float> height{-0.3f, 0.3f};
+    std::vector<GalacticPosition> positions;
+    for (size_t i = 0; i < count; ++i)
+    {
+        positions.push_back({plane(engine), plane(engine), height(engine)});
+    }
+    return positions;
+}
+
+} // namespace
+
+TEST_CASE("Spatial index radius queries")
+{
+    const auto positions = randomPositions(20000);
+    SpatialIndex index;
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        index.insert(i, positions[i]);
+    }
+    CHECK(index.size() == positions.size());
+
+    for (const GalacticPosition centre : {GalacticPosition{0.f, 0.f, 0.f},
+                                          GalacticPosition{1.3f, -0.7f, 0.1f},
+                                          GalacticPosition{-2.f, 2.f, -0.3f},
+                                          GalacticPosition{10.f, 10.f, 10.f}})
+    {
+        for (float radius : {0.05f, 0.2f, 1.f})
+        {
+            std::vector<uint64_t> expected;
+            for (size_t i = 0; i < positions.size(); ++i)
+            {
+                if (positions[i].distanceSquared(centre) <= radius * radius)
+                {
+                    expected.push_back(i);
+                }
+            }
+            CHECK(identifiers(index.withinRadius(centre, radius)) == expected);
+        }
+    }
+
+    CHECK_THROWS_AS(index.insert(0, {1e6f, 0.f, 0.f}), std::out_of_range);
+    CHECK_THROWS_AS(SpatialIndex{0.f}, std::runtime_error);
+}
+
+TEST_CASE("Spatial index nearest queries")
+{
+    const auto positions = randomPositions(5000);
+    SpatialIndex index;
+    CHECK(index.nearest({0.f, 0.f, 0.f}, 3).empty());
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        index.insert(i, positions[i]);
+    }
+
+    for (const GalacticPosition centre : {GalacticPosition{0.f, 0.f, 0.f}, GalacticPosition{5.f, 0.f, 0.f}})
+    {
+        std::vector<uint64_t> order(positions.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(),
+                  order.end(),
+                  [&](uint64_t a, uint64_t b)
+                  { return positions[a].distanceSquared(centre) < positions[b].distanceSquared(centre); });
+
+        const auto nearest = index.nearest(centre, 10);
+        REQUIRE(nearest.size() == 10);
+        for (size_t i = 0; i < nearest.size(); ++i)
+        {
+            CHECK(nearest[i].identifier == order[i]);
+        }
+    }
+    CHECK(index.nearest({0.f, 0.f, 0.f}, 10000).size() == positions.size());
+}
+
+TEST_CASE("Spatial index frustum queries")
+{
+    const auto positions = randomPositions(20000);
+    SpatialIndex index{0.1f};
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        index.insert(i, positions[i]);
+    }
+
+    // Pyramid looking along x from (-1, 0, 0), 90 degrees wide, cut at x = 1
+    const std::vector<Plane> frustum{{1.f, -1.f, 0.f, 1.f},
+                                     {1.f, 1.f, 0.f, 1.f},
+                                     {1.f, 0.f, -1.f, 1.f},
+                                     {1.f, 0.f, 1.f, 1.f},
+                                     {-1.f, 0.f, 0.f, 1.f}};
+    std::vector<uint64_t> expected;
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        const auto& p = positions[i];
+        if (std::abs(p.y) <= p.x + 1.f && std::abs(p.z) <= p.x + 1.f && p.x <= 1.f)
+        {
+            expected.push_back(i);
+        }
+    }
+    REQUIRE(!expected.empty());
+    CHECK(identifiers(index.inside(frustum)) == expected);
+    CHECK(index.inside({}).size() == positions.size());
+}
+
+TEST_CASE("Spatial index over generated systems")
+{
+    ThreadPool pool{2};
+    SpatialIndex index;
+    std::vector<SystemSummary> summaries;
+    GalaxyGenerator{pool, 256}.generate(IdentifierSet{0, 2000},
+                                        [&](std::span<const SystemSummary> batch)
+                                        {
+                                            index.insert(batch);
+                                            summaries.insert(summaries.end(), batch.begin(), batch.end());
+                                        });
+    REQUIRE(index.size() == summaries.size());
+
+    // All systems within 50 ly of the first one
+    const auto centre = GalacticPosition::of(summaries.front());
+    std::vector<uint64_t> expected;
+    for (const auto& summary : summaries)
+    {
+        if (GalacticPosition::of(summary).distanceSquared(centre) <= 0.05f * 0.05f)
+        {
+            expected.push_back(summary.identifier);
+        }
+    }
+    CHECK(identifiers(index.withinRadius(centre, 0.05f)) == expected);
+    CHECK(index.nearest(centre, 1).front().identifier == summaries.front().identifier);
+}
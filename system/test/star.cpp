@@ -22,3 +22,15 @@ TEST_CASE("Star constructor")
     CHECK(star.apparentMagnitude(Parsec{100.}).value() == Approx{absMag + 5.});
     CHECK(star.colour().hex() == "0xffbc76ff");
 }
+
+TEST_CASE("Star photometry")
+{
+    math::rng::Random rng{1};
+    Star star{std::move(rng)};
+    const double v = star.absoluteMagnitude(math::JohnsonBand::V).value();
+    const double b = star.absoluteMagnitude(math::JohnsonBand::B).value();
+    CHECK(star.colourIndex(math::JohnsonBand::B, math::JohnsonBand::V) == Approx{b - v});
+    // Cool M dwarf: red, and fainter in V than bolometric
+    CHECK(b - v > 1.);
+    CHECK(v > star.absoluteMagnitude().value());
+}
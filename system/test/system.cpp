@@ -18,3 +18,27 @@ TEST_CASE("System constructor")
     //    CHECK(system->galacticCoords().radius().value() / KiloLightYear::factor == Approx(0.00004));
     //    CHECK(system->galacticCoords().height().value() / KiloLightYear::factor == Approx(-0.4866674453));
 }
+
+TEST_CASE("System properties do not depend on the order of access")
+{
+    const auto first = ISystem::create(SystemIdentifier::fromValue(123456789));
+    CHECK(first->name() == "Zotosumexi");
+    CHECK(first->starsCount() == 1);
+    const auto summary = first->summary();
+    CHECK(summary.primaryMass == Approx(0.487214565));
+    CHECK(summary.primaryTemperature == Approx(3504.00586));
+
+    const auto second = ISystem::create(SystemIdentifier::fromValue(123456789));
+    CHECK(second->summary() == summary);
+    CHECK(second->starsCount() == 1);
+    CHECK(second->name() == "Zotosumexi");
+
+    const auto last = ISystem::create(SystemIdentifier::fromValue(SystemIdentifier::valueCount - 1));
+    CHECK(last->starsCount() == 1);
+    CHECK(last->name() == "Hagehyr");
+    CHECK(last->summary().primaryTemperature == Approx(2757.29712));
+
+    const auto multiple = ISystem::create(SystemIdentifier::fromValue(2));
+    CHECK(multiple->starsCount() == 3);
+    CHECK(multiple->summary().stars == 3);
+}
@@ -0,0 +1,134 @@
+#include <system/system_cache.h>
+
+#include <catch2/catch.hpp>
+
+#include <thread>
+
+using namespace galaxias;
+using namespace system;
+
+TEST_CASE("System cache hits and misses")
+{
+    SystemCache cache;
+    const auto first = cache.get(123456789);
+    CHECK(first->name() == ISystem::create(SystemIdentifier::fromValue(123456789))->name());
+    CHECK(cache.contains(123456789));
+    CHECK(!cache.contains(2));
+    CHECK(cache.get(123456789) == first);
+    cache.get(2);
+
+    auto statistics = cache.statistics();
+    CHECK(statistics.hits == 1);
+    CHECK(statistics.misses == 2);
+    CHECK(statistics.evictions == 0);
+    CHECK(statistics.systems == 2);
+    CHECK(statistics.bytes == first->memoryUsage() + cache.get(2)->memoryUsage());
+
+    cache.clear();
+    CHECK(!cache.contains(123456789));
+    CHECK(cache.statistics().bytes == 0);
+    // Evicted systems are still valid
+    CHECK(first->starsCount() == 1);
+}
+
+TEST_CASE("System cache evicts the least recently used systems")
+{
+    const size_t bytes = ISystem::create(SystemIdentifier::fromValue(0))->memoryUsage();
+    SystemCache cache{10 * bytes, 1};
+    for (uint64_t value = 0; value < 100; ++value)
+    {
+        cache.get(value);
+        cache.get(0);
+    }
+    const auto statistics = cache.statistics();
+    CHECK(statistics.bytes <= 10 * bytes);
+    CHECK(statistics.evictions == statistics.misses - statistics.systems);
+    CHECK(cache.contains(0));
+    CHECK(cache.contains(99));
+    CHECK(!cache.contains(1));
+}
+
+TEST_CASE("System cache budget is shared by its shards")
+{
+    // Many more shards than systems: some shards hold several of them, far over an even share of the budget
+    size_t total = 0;
+    for (uint64_t value = 0; value < 8; ++value)
+    {
+        total += ISystem::create(SystemIdentifier::fromValue(value))->memoryUsage();
+    }
+    SystemCache cache{total, 16};
+    for (uint64_t value = 0; value < 8; ++value)
+    {
+        cache.get(value);
+    }
+    auto statistics = cache.statistics();
+    CHECK(statistics.evictions == 0);
+    CHECK(statistics.systems == 8);
+    CHECK(statistics.bytes == total);
+
+    // Going over evicts as little as needed
+    cache.get(8);
+    statistics = cache.statistics();
+    CHECK(statistics.bytes <= total);
+    CHECK(statistics.evictions >= 1);
+    CHECK(statistics.systems + statistics.evictions == 9);
+}
+
+TEST_CASE("System cache pinning")
+{
+    SystemCache cache{0, 4};
+    const std::vector<uint64_t> neighbourhood{10, 11, 12};
+    cache.pin(neighbourhood);
+    cache.pin(std::vector<uint64_t>{12});
+    cache.get(13);
+    for (uint64_t value : neighbourhood)
+    {
+        CHECK(cache.contains(value));
+    }
+    CHECK(!cache.contains(13));
+    CHECK(cache.statistics().pinned == 3);
+
+    cache.clear();
+    CHECK(cache.statistics().systems == 3);
+
+    cache.unpin(neighbourhood);
+    CHECK(!cache.contains(10));
+    CHECK(cache.contains(12));
+    cache.unpinAll();
+    CHECK(!cache.contains(12));
+    CHECK(cache.statistics().systems == 0);
+}
+
+TEST_CASE("System cache is thread-safe")
+{
+    SystemCache cache{size_t{1} << 16};
+    std::vector<std::thread> threads;
+    std::vector<size_t> stars(4, 0);
+    for (size_t t = 0; t < stars.size(); ++t)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                for (uint64_t i = 0; i < 2000; ++i)
+                {
+                    stars[t] += cache.get((i * 7 + t) % 500)->summary().stars;
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    const auto statistics = cache.statistics();
+    CHECK(statistics.hits + statistics.misses == 8000);
+    CHECK(statistics.bytes <= size_t{1} << 16);
+    for (size_t t = 0; t < stars.size(); ++t)
+    {
+        size_t expected = 0;
+        for (uint64_t i = 0; i < 2000; ++i)
+        {
+            expected += ISystem::create(SystemIdentifier::fromValue((i * 7 + t) % 500))->starsCount();
+        }
+        CHECK(stars[t] == expected);
+    }
+}
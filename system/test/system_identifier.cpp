@@ -68,3 +68,25 @@ TEST_CASE("System identifier from value")
         CHECK(x.asValue() == i);
     }
 }
+
+TEST_CASE("System identifier property dice are order independent")
+{
+    const auto identifier = SystemIdentifier::fromValue(0x123456789);
+    using Property = SystemIdentifier::Property;
+
+    // Draw stars first, then the name
+    auto stars = identifier.dice(Property::Stars, 1);
+    const auto star1 = stars.uniform();
+    auto name = identifier.dice(Property::Name);
+    const auto name1 = name.uniform();
+
+    // Drawing in reverse order, or on another instance, yields the same values
+    const auto other = SystemIdentifier::fromValue(0x123456789);
+    CHECK(other.dice(Property::Name).uniform() == name1);
+    CHECK(identifier.dice(Property::Stars, 1).uniform() == star1);
+
+    // Different properties, bodies and systems yield different values
+    CHECK(identifier.dice(Property::Stars, 0).uniform() != star1);
+    CHECK(identifier.dice(Property::Planets, 1).uniform() != star1);
+    CHECK(SystemIdentifier::fromValue(0x12345678A).dice(Property::Stars, 1).uniform() != star1);
+}
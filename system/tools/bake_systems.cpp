@@ -0,0 +1,73 @@
+#include <system/catalogue.h>
+#include <system/generator.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <string>
+#include <vector>
+
+using namespace galaxias;
+using namespace system;
+
+namespace
+{
+
+void usage()
+{
+    std::fprintf(stderr,
+                 "Usage: bake_systems [--catalogue] <output> <first> <count> [threads]\n"
+                 "Generate systems with identifiers in [first, first + count) and write their summaries to output,\n"
+                 "or a full catalogue of their stars and names\n");
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> args(argv + 1, argv + argc);
+    const auto option = std::find(args.begin(), args.end(), "--catalogue");
+    const bool catalogue = option != args.end();
+    if (catalogue)
+    {
+        args.erase(option);
+    }
+    if (args.size() < 3 || args.size() > 4)
+    {
+        usage();
+        return 1;
+    }
+
+    try
+    {
+        const std::string& output = args[0];
+        const uint64_t first = std::stoull(args[1]);
+        const uint64_t count = std::stoull(args[2]);
+        ThreadPool pool{args.size() > 3 ? std::stoull(args[3]) : std::thread::hardware_concurrency()};
+        const IdentifierSet identifiers{first, first + count};
+
+        GenerationStatistics statistics;
+        if (catalogue)
+        {
+            CatalogueWriter writer;
+            statistics = writer.add(identifiers, GalaxyGenerator{pool});
+            writer.write(output);
+        }
+        else
+        {
+            SummaryFileSink sink{output};
+            statistics = GalaxyGenerator{pool}.generate(identifiers, std::ref(sink));
+        }
+        std::printf("Baked %zu systems into %s in %.1f s (%.0f systems/s)\n",
+                    statistics.systems,
+                    output.c_str(),
+                    statistics.seconds,
+                    statistics.systemsPerSecond());
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "bake_systems: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}